@@ -1,6 +1,7 @@
 #include "FontDecompressor.h"
 
 #include <Logging.h>
+#include <MemoryBudget.h>
 #include <uzlib.h>
 
 #include <cstdlib>
@@ -9,20 +10,32 @@
 bool FontDecompressor::init() {
   clearCache();
   memset(&decomp, 0, sizeof(decomp));
+  // Decompressed groups only live for a page, so they can all go when more important memory is needed
+  MemBudget.setPressureCallback(
+      MemoryBudget::Consumer::FONT_CACHE,
+      [](void* context, size_t) { static_cast<FontDecompressor*>(context)->clearCache(); }, this);
   return true;
 }
 
+void FontDecompressor::freeEntry(CacheEntry& entry) {
+  if (entry.data) {
+    free(entry.data);
+    entry.data = nullptr;
+    MemBudget.release(MemoryBudget::Consumer::FONT_CACHE, entry.dataSize);
+  }
+  entry.valid = false;
+}
+
 void FontDecompressor::freeAllEntries() {
   for (auto& entry : cache) {
-    if (entry.data) {
-      free(entry.data);
-      entry.data = nullptr;
-    }
-    entry.valid = false;
+    freeEntry(entry);
   }
 }
 
-void FontDecompressor::deinit() { freeAllEntries(); }
+void FontDecompressor::deinit() {
+  MemBudget.setPressureCallback(MemoryBudget::Consumer::FONT_CACHE, nullptr, nullptr);
+  freeAllEntries();
+}
 
 void FontDecompressor::clearCache() {
   freeAllEntries();
@@ -30,10 +43,21 @@ void FontDecompressor::clearCache() {
 }
 
 uint16_t FontDecompressor::getGroupIndex(const EpdFontData* fontData, uint16_t glyphIndex) {
-  for (uint16_t i = 0; i < fontData->groupCount; i++) {
-    uint16_t first = fontData->groups[i].firstGlyphIndex;
-    if (glyphIndex >= first && glyphIndex < first + fontData->groups[i].glyphCount) {
-      return i;
+  // Groups are laid out in glyph order: find the last group starting at or before the glyph
+  uint16_t low = 0;
+  uint16_t high = fontData->groupCount;
+  while (low < high) {
+    const uint16_t mid = (low + high) / 2;
+    if (fontData->groups[mid].firstGlyphIndex <= glyphIndex) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low > 0) {
+    const EpdFontGroup& group = fontData->groups[low - 1];
+    if (glyphIndex < group.firstGlyphIndex + group.glyphCount) {
+      return low - 1;
     }
   }
   return fontData->groupCount;  // sentinel = not found
@@ -69,16 +93,17 @@ bool FontDecompressor::decompressGroup(const EpdFontData* fontData, uint16_t gro
   const EpdFontGroup& group = fontData->groups[groupIndex];
 
   // Free old buffer if reusing a slot
-  if (entry->data) {
-    free(entry->data);
-    entry->data = nullptr;
-  }
-  entry->valid = false;
+  freeEntry(*entry);
 
   // Allocate output buffer
+  if (!MemBudget.tryReserve(MemoryBudget::Consumer::FONT_CACHE, group.uncompressedSize)) {
+    LOG_ERR("FDC", "No memory budget for %u bytes for group %u", group.uncompressedSize, groupIndex);
+    return false;
+  }
   auto* outBuf = static_cast<uint8_t*>(malloc(group.uncompressedSize));
   if (!outBuf) {
     LOG_ERR("FDC", "Failed to allocate %u bytes for group %u", group.uncompressedSize, groupIndex);
+    MemBudget.release(MemoryBudget::Consumer::FONT_CACHE, group.uncompressedSize);
     return false;
   }
 
@@ -97,6 +122,7 @@ bool FontDecompressor::decompressGroup(const EpdFontData* fontData, uint16_t gro
   if (res < 0 || decomp.dest != decomp.dest_limit) {
     LOG_ERR("FDC", "Decompression failed for group %u (status %d)", groupIndex, res);
     free(outBuf);
+    MemBudget.release(MemoryBudget::Consumer::FONT_CACHE, group.uncompressedSize);
     return false;
   }
 
@@ -18,6 +18,10 @@ class FontDecompressor {
   // Evict all cached decompressed groups (call between pages for within-page-only caching).
   void clearCache();
 
+  // Compressed group holding a glyph, fontData->groupCount when not found. Batched renderers sort glyphs by
+  // (font, group) so each group is decompressed once and stays cached while its glyphs are fetched.
+  static uint16_t getGroupIndex(const EpdFontData* fontData, uint16_t glyphIndex);
+
  private:
   static constexpr uint8_t CACHE_SLOTS = 4;
 
@@ -34,8 +38,8 @@ class FontDecompressor {
   CacheEntry cache[CACHE_SLOTS] = {};
   uint32_t accessCounter = 0;
 
+  void freeEntry(CacheEntry& entry);
   void freeAllEntries();
-  uint16_t getGroupIndex(const EpdFontData* fontData, uint16_t glyphIndex);
   CacheEntry* findInCache(const EpdFontData* fontData, uint16_t groupIndex);
   CacheEntry* findEvictionCandidate();
   bool decompressGroup(const EpdFontData* fontData, uint16_t groupIndex, CacheEntry* entry);
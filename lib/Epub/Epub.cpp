@@ -4,6 +4,7 @@
 #include <HalStorage.h>
 #include <JpegToBmpConverter.h>
 #include <Logging.h>
+#include <MemoryBudget.h>
 #include <PngToBmpConverter.h>
 #include <ZipFile.h>
 
@@ -261,8 +262,8 @@ void Epub::parseCssFiles() const {
   // Maximum CSS file size we'll attempt to parse (uncompressed)
   // Larger files risk memory exhaustion on ESP32
   constexpr size_t MAX_CSS_FILE_SIZE = 128 * 1024;  // 128KB
-  // Minimum heap required before attempting CSS parsing
-  constexpr size_t MIN_HEAP_FOR_CSS_PARSING = 64 * 1024;  // 64KB
+  // Working memory reserved while parsing a CSS file
+  constexpr size_t CSS_PARSING_BYTES = 32 * 1024;  // 32KB
 
   if (cssFiles.empty()) {
     LOG_DBG("EBP", "No CSS files to parse, but CssParser created for inline styles");
@@ -280,11 +281,11 @@ void Epub::parseCssFiles() const {
   for (const auto& cssPath : cssFiles) {
     LOG_DBG("EBP", "Parsing CSS file: %s", cssPath.c_str());
 
-    // Check heap before parsing - CSS parsing allocates heavily
-    const uint32_t freeHeap = ESP.getFreeHeap();
-    if (freeHeap < MIN_HEAP_FOR_CSS_PARSING) {
-      LOG_ERR("EBP", "Insufficient heap for CSS parsing (%u bytes free, need %zu), skipping: %s", freeHeap,
-              MIN_HEAP_FOR_CSS_PARSING, cssPath.c_str());
+    // Reserve before parsing - CSS parsing allocates heavily
+    const ScopedReservation reservation(MemoryBudget::Consumer::CSS, CSS_PARSING_BYTES);
+    if (!reservation) {
+      LOG_ERR("EBP", "Insufficient heap for CSS parsing (%u bytes free), skipping: %s", ESP.getFreeHeap(),
+              cssPath.c_str());
       continue;
     }
 
@@ -341,6 +342,7 @@ bool Epub::load(const bool buildIfMissing, const bool skipLoadingCss) {
   bookMetadataCache.reset(new BookMetadataCache(cachePath));
   // Always create CssParser - needed for inline style parsing even without CSS files
   cssParser.reset(new CssParser(cachePath));
+  imageManifest.reset(new ImageManifest(cachePath));
 
   // Try to load existing cache first
   if (bookMetadataCache->load()) {
@@ -369,100 +371,131 @@ bool Epub::load(const bool buildIfMissing, const bool skipLoadingCss) {
   }
 
   // Cache doesn't exist or is invalid, build it
-  LOG_DBG("EBP", "Cache not found, building spine/TOC cache");
-  setupCacheDir();
-
-  const uint32_t indexingStart = millis();
-
-  // Begin building cache - stream entries to disk immediately
-  if (!bookMetadataCache->beginWrite()) {
-    LOG_ERR("EBP", "Could not begin writing cache");
-    return false;
+  bool built = false;
+  while (!built) {
+    if (!buildCacheStep(built)) {
+      return false;
+    }
   }
 
-  // OPF Pass
-  const uint32_t opfStart = millis();
-  BookMetadataCache::BookMetadata bookMetadata;
-  if (!bookMetadataCache->beginContentOpfPass()) {
-    LOG_ERR("EBP", "Could not begin writing content.opf pass");
-    return false;
-  }
-  if (!parseContentOpf(bookMetadata)) {
-    LOG_ERR("EBP", "Could not parse content.opf");
-    return false;
-  }
-  if (!bookMetadataCache->endContentOpfPass()) {
-    LOG_ERR("EBP", "Could not end writing content.opf pass");
-    return false;
+  if (!skipLoadingCss) {
+    // Parse CSS files after cache reload
+    parseCssFiles();
+    Storage.removeDir((cachePath + "/sections").c_str());
   }
-  LOG_DBG("EBP", "OPF pass completed in %lu ms", millis() - opfStart);
 
-  // TOC Pass - try EPUB 3 nav first, fall back to NCX
-  const uint32_t tocStart = millis();
-  if (!bookMetadataCache->beginTocPass()) {
-    LOG_ERR("EBP", "Could not begin writing toc pass");
-    return false;
-  }
+  LOG_DBG("EBP", "Loaded ePub: %s", filepath.c_str());
+  return true;
+}
 
-  bool tocParsed = false;
+bool Epub::buildCacheStep(bool& done) {
+  done = false;
+  const BuildPass pass = buildPass;
+  // Any failure restarts the build from the first pass
+  buildPass = BuildPass::OPF;
+
+  switch (pass) {
+    case BuildPass::OPF: {
+      LOG_DBG("EBP", "Cache not found, building spine/TOC cache");
+      setupCacheDir();
+      buildStart = millis();
+      buildMetadata = {};
+      if (!bookMetadataCache) {
+        bookMetadataCache.reset(new BookMetadataCache(cachePath));
+      }
 
-  // Try EPUB 3 nav document first (preferred)
-  if (!tocNavItem.empty()) {
-    LOG_DBG("EBP", "Attempting to parse EPUB 3 nav document");
-    tocParsed = parseTocNavFile();
-  }
+      // Begin building cache - stream entries to disk immediately
+      if (!bookMetadataCache->beginWrite()) {
+        LOG_ERR("EBP", "Could not begin writing cache");
+        return false;
+      }
 
-  // Fall back to NCX if nav parsing failed or wasn't available
-  if (!tocParsed && !tocNcxItem.empty()) {
-    LOG_DBG("EBP", "Falling back to NCX TOC");
-    tocParsed = parseTocNcxFile();
-  }
+      // OPF Pass
+      const uint32_t opfStart = millis();
+      if (!bookMetadataCache->beginContentOpfPass()) {
+        LOG_ERR("EBP", "Could not begin writing content.opf pass");
+        return false;
+      }
+      if (!parseContentOpf(buildMetadata)) {
+        LOG_ERR("EBP", "Could not parse content.opf");
+        return false;
+      }
+      if (!bookMetadataCache->endContentOpfPass()) {
+        LOG_ERR("EBP", "Could not end writing content.opf pass");
+        return false;
+      }
+      LOG_DBG("EBP", "OPF pass completed in %lu ms", millis() - opfStart);
+      buildPass = BuildPass::TOC;
+      return true;
+    }
 
-  if (!tocParsed) {
-    LOG_ERR("EBP", "Warning: Could not parse any TOC format");
-    // Continue anyway - book will work without TOC
-  }
+    case BuildPass::TOC: {
+      // TOC Pass - try EPUB 3 nav first, fall back to NCX
+      const uint32_t tocStart = millis();
+      if (!bookMetadataCache->beginTocPass()) {
+        LOG_ERR("EBP", "Could not begin writing toc pass");
+        return false;
+      }
 
-  if (!bookMetadataCache->endTocPass()) {
-    LOG_ERR("EBP", "Could not end writing toc pass");
-    return false;
-  }
-  LOG_DBG("EBP", "TOC pass completed in %lu ms", millis() - tocStart);
+      bool tocParsed = false;
 
-  // Close the cache files
-  if (!bookMetadataCache->endWrite()) {
-    LOG_ERR("EBP", "Could not end writing cache");
-    return false;
-  }
+      // Try EPUB 3 nav document first (preferred)
+      if (!tocNavItem.empty()) {
+        LOG_DBG("EBP", "Attempting to parse EPUB 3 nav document");
+        tocParsed = parseTocNavFile();
+      }
 
-  // Build final book.bin
-  const uint32_t buildStart = millis();
-  if (!bookMetadataCache->buildBookBin(filepath, bookMetadata)) {
-    LOG_ERR("EBP", "Could not update mappings and sizes");
-    return false;
-  }
-  LOG_DBG("EBP", "buildBookBin completed in %lu ms", millis() - buildStart);
-  LOG_DBG("EBP", "Total indexing completed in %lu ms", millis() - indexingStart);
+      // Fall back to NCX if nav parsing failed or wasn't available
+      if (!tocParsed && !tocNcxItem.empty()) {
+        LOG_DBG("EBP", "Falling back to NCX TOC");
+        tocParsed = parseTocNcxFile();
+      }
 
-  if (!bookMetadataCache->cleanupTmpFiles()) {
-    LOG_DBG("EBP", "Could not cleanup tmp files - ignoring");
-  }
+      if (!tocParsed) {
+        LOG_ERR("EBP", "Warning: Could not parse any TOC format");
+        // Continue anyway - book will work without TOC
+      }
 
-  // Reload the cache from disk so it's in the correct state
-  bookMetadataCache.reset(new BookMetadataCache(cachePath));
-  if (!bookMetadataCache->load()) {
-    LOG_ERR("EBP", "Failed to reload cache after writing");
-    return false;
-  }
+      if (!bookMetadataCache->endTocPass()) {
+        LOG_ERR("EBP", "Could not end writing toc pass");
+        return false;
+      }
+      LOG_DBG("EBP", "TOC pass completed in %lu ms", millis() - tocStart);
+      buildPass = BuildPass::BOOK_BIN;
+      return true;
+    }
 
-  if (!skipLoadingCss) {
-    // Parse CSS files after cache reload
-    parseCssFiles();
-    Storage.removeDir((cachePath + "/sections").c_str());
-  }
+    case BuildPass::BOOK_BIN: {
+      // Close the cache files
+      if (!bookMetadataCache->endWrite()) {
+        LOG_ERR("EBP", "Could not end writing cache");
+        return false;
+      }
 
-  LOG_DBG("EBP", "Loaded ePub: %s", filepath.c_str());
-  return true;
+      // Build final book.bin
+      const uint32_t bookBinStart = millis();
+      if (!bookMetadataCache->buildBookBin(filepath, buildMetadata)) {
+        LOG_ERR("EBP", "Could not update mappings and sizes");
+        return false;
+      }
+      LOG_DBG("EBP", "buildBookBin completed in %lu ms", millis() - bookBinStart);
+      LOG_DBG("EBP", "Total indexing completed in %lu ms", millis() - buildStart);
+
+      if (!bookMetadataCache->cleanupTmpFiles()) {
+        LOG_DBG("EBP", "Could not cleanup tmp files - ignoring");
+      }
+
+      // Reload the cache from disk so it's in the correct state
+      bookMetadataCache.reset(new BookMetadataCache(cachePath));
+      if (!bookMetadataCache->load()) {
+        LOG_ERR("EBP", "Failed to reload cache after writing");
+        return false;
+      }
+      done = true;
+      return true;
+    }
+  }
+  return false;
 }
 
 bool Epub::clearCache() const {
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "Epub/BookMetadataCache.h"
+#include "Epub/ImageManifest.h"
 #include "Epub/css/CssParser.h"
 
 class ZipFile;
@@ -27,8 +28,15 @@ class Epub {
   std::unique_ptr<BookMetadataCache> bookMetadataCache;
   // CSS parser for styling
   std::unique_ptr<CssParser> cssParser;
+  // Extracted image manifest, shared by all sections
+  std::unique_ptr<ImageManifest> imageManifest;
   // CSS files
   std::vector<std::string> cssFiles;
+  // Progress of a spine/TOC cache build, see buildCacheStep
+  enum class BuildPass : uint8_t { OPF, TOC, BOOK_BIN };
+  BuildPass buildPass = BuildPass::OPF;
+  BookMetadataCache::BookMetadata buildMetadata;
+  uint32_t buildStart = 0;
 
   bool findContentOpfFile(std::string* contentOpfFile) const;
   bool parseContentOpf(BookMetadataCache::BookMetadata& bookMetadata);
@@ -44,6 +52,9 @@ class Epub {
   ~Epub() = default;
   std::string& getBasePath() { return contentBasePath; }
   bool load(bool buildIfMissing = true, bool skipLoadingCss = false);
+  // Build the spine/TOC cache one pass per call (content.opf, TOC, book.bin), so a caller can serve other work in
+  // between. Returns false on failure and sets done once the cache is built and loaded. load() runs every pass.
+  bool buildCacheStep(bool& done);
   bool clearCache() const;
   void setupCacheDir() const;
   const std::string& getCachePath() const;
@@ -72,4 +83,5 @@ class Epub {
   size_t getBookSize() const;
   float calculateProgress(int currentSpineIndex, float currentSpineRead) const;
   CssParser* getCssParser() const { return cssParser.get(); }
+  ImageManifest* getImageManifest() const { return imageManifest.get(); }
 };
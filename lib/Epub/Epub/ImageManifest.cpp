@@ -0,0 +1,177 @@
+#include "ImageManifest.h"
+
+#include <HalStorage.h>
+#include <Logging.h>
+#include <Serialization.h>
+#include <ZipFile.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr uint8_t IMAGE_MANIFEST_VERSION = 1;
+constexpr char manifestFile[] = "/images.bin";
+constexpr char imagePrefix[] = "img_";
+constexpr size_t IMAGE_HASH_DIGITS = 16;
+
+// Failures are only remembered for the current session so a later rebuild retries them
+bool isFailure(const ImageManifest::Entry& entry) { return entry.width <= 0 || entry.height <= 0; }
+}  // namespace
+
+bool ImageManifest::load() {
+  if (loaded) {
+    return true;
+  }
+  loaded = true;
+  dirty = false;
+  entries.clear();
+
+  prunedCount = 0;
+
+  if (!Storage.exists((cachePath + manifestFile).c_str())) {
+    pruneUnlisted();
+    return true;
+  }
+
+  FsFile file;
+  if (!Storage.openFileForRead("IMF", cachePath + manifestFile, file)) {
+    return false;
+  }
+
+  uint8_t version = 0;
+  serialization::readPod(file, version);
+  if (version != IMAGE_MANIFEST_VERSION) {
+    LOG_DBG("IMF", "Manifest version mismatch (got %u, expected %u), starting fresh", version, IMAGE_MANIFEST_VERSION);
+    file.close();
+    Storage.remove((cachePath + manifestFile).c_str());
+    pruneUnlisted();
+    return true;
+  }
+
+  uint16_t count = 0;
+  serialization::readPod(file, count);
+  entries.reserve(count);
+  for (uint16_t i = 0; i < count && file.available(); i++) {
+    uint64_t hash;
+    Entry entry;
+    serialization::readPod(file, hash);
+    serialization::readPod(file, entry.pathLen);
+    serialization::readPod(file, entry.width);
+    serialization::readPod(file, entry.height);
+    serialization::readString(file, entry.ext);
+    if (!isFailure(entry)) {
+      entries.emplace(hash, std::move(entry));
+    }
+  }
+  file.close();
+
+  LOG_DBG("IMF", "Loaded %u image manifest entries", static_cast<unsigned>(entries.size()));
+  pruneUnlisted();
+  return true;
+}
+
+// Delete extracted images (and the pixel caches next to them) that no manifest entry refers to. They are left
+// behind when the manifest is started fresh, and would otherwise stay in the book cache forever.
+void ImageManifest::pruneUnlisted() {
+  FsFile dir = Storage.open(cachePath.c_str());
+  if (!dir || !dir.isDirectory()) {
+    if (dir) dir.close();
+    return;
+  }
+
+  const size_t prefixLen = sizeof(imagePrefix) - 1;
+  std::vector<std::string> orphans;
+  char name[64];
+  for (FsFile entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+    entry.getName(name, sizeof(name));
+    const bool isDirectory = entry.isDirectory();
+    entry.close();
+
+    // "img_<16 hex digits>" followed by the image or cache extension
+    if (isDirectory || strncmp(name, imagePrefix, prefixLen) != 0 || strlen(name) < prefixLen + IMAGE_HASH_DIGITS) {
+      continue;
+    }
+    char digits[IMAGE_HASH_DIGITS + 1];
+    memcpy(digits, name + prefixLen, IMAGE_HASH_DIGITS);
+    digits[IMAGE_HASH_DIGITS] = '\0';
+    char* end = nullptr;
+    const uint64_t hash = strtoull(digits, &end, 16);
+    if (end != digits + IMAGE_HASH_DIGITS) {
+      continue;
+    }
+    if (entries.find(hash) == entries.end()) {
+      orphans.emplace_back(cachePath + "/" + name);
+    }
+  }
+  dir.close();
+
+  for (const auto& path : orphans) {
+    Storage.remove(path.c_str());
+  }
+  prunedCount = orphans.size();
+  if (prunedCount > 0) {
+    LOG_DBG("IMF", "Pruned %u unreferenced image files", static_cast<unsigned>(prunedCount));
+  }
+}
+
+bool ImageManifest::save() {
+  if (!dirty) {
+    return true;
+  }
+
+  FsFile file;
+  if (!Storage.openFileForWrite("IMF", cachePath + manifestFile, file)) {
+    return false;
+  }
+
+  uint16_t count = 0;
+  for (const auto& [hash, entry] : entries) {
+    if (!isFailure(entry)) {
+      count++;
+    }
+  }
+
+  serialization::writePod(file, IMAGE_MANIFEST_VERSION);
+  serialization::writePod(file, count);
+  for (const auto& [hash, entry] : entries) {
+    if (isFailure(entry)) {
+      continue;
+    }
+    serialization::writePod(file, hash);
+    serialization::writePod(file, entry.pathLen);
+    serialization::writePod(file, entry.width);
+    serialization::writePod(file, entry.height);
+    serialization::writeString(file, entry.ext);
+  }
+  file.close();
+  dirty = false;
+
+  LOG_DBG("IMF", "Saved %u image manifest entries", static_cast<unsigned>(count));
+  return true;
+}
+
+const ImageManifest::Entry* ImageManifest::find(const std::string& zipPath) const {
+  const auto it = entries.find(ZipFile::fnvHash64(zipPath.data(), zipPath.size()));
+  if (it == entries.end() || it->second.pathLen != static_cast<uint16_t>(zipPath.size())) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void ImageManifest::put(const std::string& zipPath, const std::string& ext, const int16_t width, const int16_t height) {
+  Entry& entry = entries[ZipFile::fnvHash64(zipPath.data(), zipPath.size())];
+  entry.pathLen = static_cast<uint16_t>(zipPath.size());
+  entry.width = width;
+  entry.height = height;
+  entry.ext = ext;
+  dirty = true;
+}
+
+std::string ImageManifest::getImagePath(const std::string& zipPath, const std::string& ext) const {
+  char name[24];
+  snprintf(name, sizeof(name), "/img_%016llx",
+           static_cast<unsigned long long>(ZipFile::fnvHash64(zipPath.data(), zipPath.size())));
+  return cachePath + name + ext;
+}
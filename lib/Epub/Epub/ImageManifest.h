@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Per-book manifest of images extracted from the EPUB archive.
+ *
+ * Extracted images are content-addressed by the FNV-1a hash of their normalised ZIP entry path, so an image
+ * referenced from many chapters (logos, ornaments, dividers) is extracted and measured once per book. The
+ * manifest keeps the measured source dimensions, which lets section rebuilds (e.g. after a font change) lay
+ * out images without any image I/O.
+ */
+class ImageManifest {
+ public:
+  struct Entry {
+    uint16_t pathLen;  // Length of the ZIP path for collision reduction
+    int16_t width;     // Source dimensions, 0x0 when the image could not be measured (never persisted)
+    int16_t height;
+    std::string ext;  // Extension of the extracted file, including the dot
+  };
+
+  explicit ImageManifest(std::string cachePath) : cachePath(std::move(cachePath)) {}
+  ~ImageManifest() = default;
+
+  // Load the manifest from disk and delete extracted images it no longer lists. Safe to call repeatedly, only the
+  // first call touches the SD card.
+  bool load();
+  // Persist the manifest if it changed since the last load/save.
+  bool save();
+
+  // Look up a previously extracted image by normalised ZIP path. Returns nullptr if unknown.
+  const Entry* find(const std::string& zipPath) const;
+  // Record the outcome of extracting an image. A 0x0 size marks an image that failed to measure, it is skipped for the
+  // rest of the session but not saved, so the next rebuild retries it.
+  void put(const std::string& zipPath, const std::string& ext, int16_t width, int16_t height);
+  // Path of the extracted copy of an image inside the book cache directory
+  std::string getImagePath(const std::string& zipPath, const std::string& ext) const;
+
+  size_t size() const { return entries.size(); }
+  // Number of unreferenced extracted images the last load() deleted
+  size_t getPrunedCount() const { return prunedCount; }
+
+ private:
+  void pruneUnlisted();
+
+  std::string cachePath;
+  std::unordered_map<uint64_t, Entry> entries;
+  size_t prunedCount = 0;
+  bool loaded = false;
+  bool dirty = false;
+};
@@ -30,6 +30,10 @@ void PageImage::render(GfxRenderer& renderer, const int fontId, const int xOffse
   imageBlock->render(renderer, xPos + xOffset, yPos + yOffset);
 }
 
+bool PageImage::prerender(GfxRenderer& renderer, const int xOffset, const int yOffset) const {
+  return imageBlock->prerender(renderer, xPos + xOffset, yPos + yOffset);
+}
+
 bool PageImage::serialize(FsFile& file) {
   serialization::writePod(file, xPos);
   serialization::writePod(file, yPos);
@@ -50,6 +50,7 @@ class PageImage final : public PageElement {
   PageElementTag getTag() const override { return TAG_PageImage; }
   static std::unique_ptr<PageImage> deserialize(FsFile& file);
   const ImageBlock& getImageBlock() const { return *imageBlock; }
+  bool prerender(GfxRenderer& renderer, int xOffset, int yOffset) const;
 };
 
 class Page {
@@ -9,10 +9,22 @@
 #include <limits>
 #include <vector>
 
+#include "WordWidthCache.h"
+#include "hyphenation/BreakOffsetCache.h"
 #include "hyphenation/Hyphenator.h"
 
 constexpr int MAX_COST = std::numeric_limits<int>::max();
 
+// Optimal (Knuth-Plass) layout, used when hyphenation is enabled.
+// Words searched per window; bounds the breakpoint nodes held at once on very long paragraphs.
+constexpr size_t KP_WINDOW_WORDS = 192;
+// Lines at the end of a window that are left for the next window to reconsider
+constexpr size_t KP_WINDOW_TAIL_LINES = 2;
+// A split word costs as much as this many spaces of slack on a line
+constexpr int KP_HYPHEN_PENALTY_SPACES = 2;
+// Cost of an overfull line forced by an unbreakable run wider than the page
+constexpr int64_t KP_OVERFULL_DEMERITS = 1000000000LL;
+
 namespace {
 
 // Soft hyphen byte pattern used throughout EPUBs (UTF-8 for U+00AD).
@@ -29,27 +41,35 @@ void stripSoftHyphensInPlace(std::string& word) {
   }
 }
 
-// Returns the advance width for a word while ignoring soft hyphen glyphs and optionally appending a visible hyphen.
+// Returns the advance width for a word while ignoring soft hyphen glyphs.
 // Uses advance width (sum of glyph advances) rather than bounding box width so that italic glyph overhangs
 // don't inflate inter-word spacing.
 uint16_t measureWordWidth(const GfxRenderer& renderer, const int fontId, const std::string& word,
-                          const EpdFontFamily::Style style, const bool appendHyphen = false) {
-  if (word.size() == 1 && word[0] == ' ' && !appendHyphen) {
+                          const EpdFontFamily::Style style) {
+  if (word.size() == 1 && word[0] == ' ') {
     return renderer.getSpaceWidth(fontId, style);
   }
-  const bool hasSoftHyphen = containsSoftHyphen(word);
-  if (!hasSoftHyphen && !appendHyphen) {
+  if (!containsSoftHyphen(word)) {
     return renderer.getTextAdvanceX(fontId, word.c_str(), style);
   }
 
   std::string sanitized = word;
-  if (hasSoftHyphen) {
-    stripSoftHyphensInPlace(sanitized);
+  stripSoftHyphensInPlace(sanitized);
+  return renderer.getTextAdvanceX(fontId, sanitized.c_str(), style);
+}
+
+// Whole-word width, memoized in the chapter's width cache when one is provided.
+uint16_t measureWordWidthCached(const GfxRenderer& renderer, WordWidthCache* cache, const int fontId,
+                                const std::string& word, const EpdFontFamily::Style style) {
+  uint16_t width = 0;
+  if (cache && cache->find(fontId, style, word, width)) {
+    return width;
   }
-  if (appendHyphen) {
-    sanitized.push_back('-');
+  width = measureWordWidth(renderer, fontId, word, style);
+  if (cache) {
+    cache->put(fontId, style, word, width);
   }
-  return renderer.getTextAdvanceX(fontId, sanitized.c_str(), style);
+  return width;
 }
 
 }  // namespace
@@ -70,13 +90,17 @@ void ParsedText::addWord(std::string word, const EpdFontFamily::Style fontStyle,
 // Consumes data to minimize memory usage
 void ParsedText::layoutAndExtractLines(const GfxRenderer& renderer, const int fontId, const uint16_t viewportWidth,
                                        const std::function<void(std::shared_ptr<TextBlock>)>& processLine,
-                                       const bool includeLastLine) {
+                                       const bool includeLastLine, WordWidthCache* widthCache,
+                                       BreakOffsetCache* breakCache) {
   if (words.empty()) {
     return;
   }
+  this->widthCache = widthCache;
+  this->breakCache = breakCache;
 
   // Apply fixed transforms before any per-line layout work.
   applyParagraphIndent();
+  resetCursor();
 
   const int pageWidth = viewportWidth;
   const int spaceWidth = renderer.getSpaceWidth(fontId);
@@ -87,8 +111,8 @@ void ParsedText::layoutAndExtractLines(const GfxRenderer& renderer, const int fo
 
   std::vector<size_t> lineBreakIndices;
   if (hyphenationEnabled) {
-    // Use greedy layout that can split words mid-loop when a hyphenated prefix fits.
-    lineBreakIndices = computeHyphenatedLineBreaks(renderer, fontId, pageWidth, spaceWidth, wordWidths, continuesVec);
+    // Knuth-Plass layout that weighs hyphenated breaks against looser lines.
+    lineBreakIndices = computeOptimalLineBreaks(renderer, fontId, pageWidth, spaceWidth, wordWidths, continuesVec);
   } else {
     lineBreakIndices = computeLineBreaks(renderer, fontId, pageWidth, spaceWidth, wordWidths, continuesVec);
   }
@@ -97,6 +121,26 @@ void ParsedText::layoutAndExtractLines(const GfxRenderer& renderer, const int fo
   for (size_t i = 0; i < lineCount; ++i) {
     extractLine(i, pageWidth, spaceWidth, wordWidths, continuesVec, lineBreakIndices, processLine);
   }
+  this->widthCache = nullptr;
+  this->breakCache = nullptr;
+}
+
+void ParsedText::resetCursor() {
+  cursor.index = 0;
+  cursor.word = words.begin();
+  cursor.style = wordStyles.begin();
+  cursor.continues = wordContinues.begin();
+}
+
+void ParsedText::seekWord(const size_t wordIndex) {
+  if (wordIndex < cursor.index) {
+    resetCursor();
+  }
+  const auto steps = static_cast<std::ptrdiff_t>(wordIndex - cursor.index);
+  std::advance(cursor.word, steps);
+  std::advance(cursor.style, steps);
+  std::advance(cursor.continues, steps);
+  cursor.index = wordIndex;
 }
 
 std::vector<uint16_t> ParsedText::calculateWordWidths(const GfxRenderer& renderer, const int fontId) {
@@ -109,7 +153,7 @@ std::vector<uint16_t> ParsedText::calculateWordWidths(const GfxRenderer& rendere
   auto wordStylesIt = wordStyles.begin();
 
   while (wordsIt != words.end()) {
-    wordWidths.push_back(measureWordWidth(renderer, fontId, *wordsIt, *wordStylesIt));
+    wordWidths.push_back(measureWordWidthCached(renderer, widthCache, fontId, *wordsIt, *wordStylesIt));
 
     std::advance(wordsIt, 1);
     std::advance(wordStylesIt, 1);
@@ -132,17 +176,7 @@ std::vector<size_t> ParsedText::computeLineBreaks(const GfxRenderer& renderer, c
           ? blockStyle.textIndent
           : 0;
 
-  // Ensure any word that would overflow even as the first entry on a line is split using fallback hyphenation.
-  for (size_t i = 0; i < wordWidths.size(); ++i) {
-    // First word needs to fit in reduced width if there's an indent
-    const int effectiveWidth = i == 0 ? pageWidth - firstLineIndent : pageWidth;
-    while (wordWidths[i] > effectiveWidth) {
-      if (!hyphenateWordAtIndex(i, effectiveWidth, renderer, fontId, wordWidths, /*allowFallbackBreaks=*/true,
-                                &continuesVec)) {
-        break;
-      }
-    }
-  }
+  splitOversizedWords(renderer, fontId, pageWidth, firstLineIndent, wordWidths, continuesVec);
 
   const size_t totalWordCount = words.size();
 
@@ -244,11 +278,29 @@ void ParsedText::applyParagraphIndent() {
   }
 }
 
-// Builds break indices while opportunistically splitting the word that would overflow the current line.
-std::vector<size_t> ParsedText::computeHyphenatedLineBreaks(const GfxRenderer& renderer, const int fontId,
-                                                            const int pageWidth, const int spaceWidth,
-                                                            std::vector<uint16_t>& wordWidths,
-                                                            std::vector<bool>& continuesVec) {
+// Ensure any word that would overflow even as the first entry on a line is split using fallback hyphenation.
+void ParsedText::splitOversizedWords(const GfxRenderer& renderer, const int fontId, const int pageWidth,
+                                     const int firstLineIndent, std::vector<uint16_t>& wordWidths,
+                                     std::vector<bool>& continuesVec) {
+  for (size_t i = 0; i < wordWidths.size(); ++i) {
+    // First word needs to fit in reduced width if there's an indent
+    const int effectiveWidth = i == 0 ? pageWidth - firstLineIndent : pageWidth;
+    while (wordWidths[i] > effectiveWidth) {
+      if (!hyphenateWordAtIndex(i, effectiveWidth, renderer, fontId, wordWidths, /*allowFallbackBreaks=*/true,
+                                &continuesVec)) {
+        break;
+      }
+    }
+  }
+}
+
+// Knuth-Plass line breaking. Breaks between words and at hyphenation points inside words are weighed together, so a
+// hyphen is only used where it buys noticeably tighter spacing. The search itself never touches the word lists;
+// chosen hyphenations are applied once a window is decided.
+std::vector<size_t> ParsedText::computeOptimalLineBreaks(const GfxRenderer& renderer, const int fontId,
+                                                         const int pageWidth, const int spaceWidth,
+                                                         std::vector<uint16_t>& wordWidths,
+                                                         std::vector<bool>& continuesVec) {
   // Calculate first line indent (only for left/justified text without extra paragraph spacing)
   const int firstLineIndent =
       blockStyle.textIndent > 0 && !extraParagraphSpacing &&
@@ -257,60 +309,218 @@ std::vector<size_t> ParsedText::computeHyphenatedLineBreaks(const GfxRenderer& r
           : 0;
 
   std::vector<size_t> lineBreakIndices;
-  size_t currentIndex = 0;
-  bool isFirstLine = true;
+  std::vector<LineBreak> breaks;
+  size_t windowStart = 0;
+
+  while (windowStart < wordWidths.size()) {
+    breaks.clear();
+    const int firstLineWidth = windowStart == 0 ? pageWidth - firstLineIndent : pageWidth;
+    searchLineBreaks(renderer, fontId, firstLineWidth, pageWidth, spaceWidth, windowStart, wordWidths, continuesVec,
+                     breaks);
+
+    // Apply the chosen splits. Each split inserts a word, shifting every later index of this window by one.
+    size_t shift = 0;
+    size_t lastSplitWord = wordWidths.size();
+    size_t lastSplitOffset = 0;
+    for (const auto& lineBreak : breaks) {
+      if (lineBreak.offset > 0) {
+        const size_t wordIndex = lineBreak.word + shift;
+        // A second break in the same word is relative to the remainder left by the first
+        const size_t offset = lineBreak.offset - (lineBreak.word == lastSplitWord ? lastSplitOffset : 0);
+
+        seekWord(wordIndex);
+        renderer.getTextPrefixAdvances(fontId, *cursor.word, *cursor.style, prefixAdvances);
+        const int hyphenWidth = lineBreak.insertHyphen ? renderer.getTextAdvanceX(fontId, "-", *cursor.style) : 0;
+        const auto prefixWidth = static_cast<uint16_t>(prefixAdvances[offset] + hyphenWidth);
+        const auto remainderWidth = static_cast<uint16_t>(prefixAdvances.back() - prefixAdvances[offset]);
+        splitWordAt(wordIndex, offset, lineBreak.insertHyphen, prefixWidth, remainderWidth, wordWidths,
+                    &continuesVec);
+
+        shift++;
+        lastSplitWord = lineBreak.word;
+        lastSplitOffset = lineBreak.offset;
+      }
+      lineBreakIndices.push_back(lineBreak.word + shift);
+    }
+
+    if (lineBreakIndices.empty() || lineBreakIndices.back() <= windowStart) {
+      // Safety net, the search always makes progress: put one word on the line
+      lineBreakIndices.push_back(windowStart + 1);
+    }
+    windowStart = lineBreakIndices.back();
+  }
 
-  while (currentIndex < wordWidths.size()) {
-    const size_t lineStart = currentIndex;
-    int lineWidth = 0;
+  return lineBreakIndices;
+}
 
-    // First line has reduced width due to text-indent
-    const int effectivePageWidth = isFirstLine ? pageWidth - firstLineIndent : pageWidth;
-
-    // Consume as many words as possible for current line, splitting when prefixes fit
-    while (currentIndex < wordWidths.size()) {
-      const bool isFirstWord = currentIndex == lineStart;
-      const int spacing = isFirstWord || continuesVec[currentIndex] ? 0 : spaceWidth;
-      const int candidateWidth = spacing + wordWidths[currentIndex];
-
-      // Word fits on current line
-      if (lineWidth + candidateWidth <= effectivePageWidth) {
-        lineWidth += candidateWidth;
-        ++currentIndex;
+namespace {
+
+struct BreakNode {
+  int64_t demerits;   // Total cost of the lines up to this break
+  int32_t position;   // Where the line after this break starts, in the window laid out as one unbroken line
+  uint16_t word;      // The line after this break starts at this word...
+  uint16_t offset;    // ...at this byte offset, non-zero when the word is split
+  int32_t previous;   // Node of the break before, -1 for the window start
+  bool insertHyphen;  // The split needs a visible hyphen (not already a hyphen in the text)
+};
+
+}  // namespace
+
+// Searches the words from windowStart on and appends the breaks to commit. Lines are evaluated from every active
+// node to each breakpoint in order; a node is dropped once a line from it overflows, since every later breakpoint
+// is further along. When the window does not reach the paragraph end, its last lines are left for the next window.
+void ParsedText::searchLineBreaks(const GfxRenderer& renderer, const int fontId, const int firstLineWidth,
+                                  const int pageWidth, const int spaceWidth, const size_t windowStart,
+                                  const std::vector<uint16_t>& wordWidths, const std::vector<bool>& continuesVec,
+                                  std::vector<LineBreak>& breaks) {
+  const size_t totalWordCount = wordWidths.size();
+  const size_t windowEnd = std::min(totalWordCount, windowStart + KP_WINDOW_WORDS);
+  const int64_t hyphenPenalty = static_cast<int64_t>(KP_HYPHEN_PENALTY_SPACES * spaceWidth) *
+                                (KP_HYPHEN_PENALTY_SPACES * spaceWidth);
+
+  std::vector<BreakNode> nodes;
+  nodes.reserve(windowEnd - windowStart + 1);
+  nodes.push_back({0, 0, static_cast<uint16_t>(windowStart), 0, -1, false});
+  std::vector<int> active = {0};
+  // Cheapest node dropped since a node was last added; continues the layout if a run is too wide for any line
+  int rescue = -1;
+  int finalNode = -1;
+
+  const auto lineWidthFrom = [&](const int node) { return node == 0 ? firstLineWidth : pageWidth; };
+
+  // Evaluate a breakpoint: the line ends at lineEnd (plus hyphenWidth when the break inserts a hyphen), and the next
+  // line starts at nextStart.
+  const auto tryBreak = [&](const size_t word, const size_t offset, const int32_t lineEnd, const int hyphenWidth,
+                            const int32_t nextStart, const bool insertHyphen, const bool isLast) {
+    int64_t best = std::numeric_limits<int64_t>::max();
+    int bestPrevious = -1;
+
+    for (size_t i = 0; i < active.size();) {
+      const int node = active[i];
+      const int available = lineWidthFrom(node);
+      const int32_t width = lineEnd - nodes[node].position;
+      if (width > available) {
+        if (rescue < 0 || nodes[node].demerits < nodes[rescue].demerits) {
+          rescue = node;
+        }
+        active.erase(active.begin() + i);
         continue;
       }
+      ++i;
 
-      // Word would overflow — try to split based on hyphenation points
-      const int availableWidth = effectivePageWidth - lineWidth - spacing;
-      const bool allowFallbackBreaks = isFirstWord;  // Only for first word on line
-
-      if (availableWidth > 0 && hyphenateWordAtIndex(currentIndex, availableWidth, renderer, fontId, wordWidths,
-                                                     allowFallbackBreaks, &continuesVec)) {
-        // Prefix now fits; append it to this line and move to next line
-        lineWidth += spacing + wordWidths[currentIndex];
-        ++currentIndex;
-        break;
+      const int64_t slack = available - (width + hyphenWidth);
+      if (slack < 0) {
+        continue;  // Only the added hyphen does not fit
+      }
+      int64_t demerits = nodes[node].demerits + (isLast ? 0 : slack * slack);
+      if (offset > 0) {
+        demerits += hyphenPenalty;
+        // Stacked hyphens on consecutive lines cost double
+        if (nodes[node].offset > 0) {
+          demerits += hyphenPenalty;
+        }
       }
+      if (demerits < best) {
+        best = demerits;
+        bestPrevious = node;
+      }
+    }
+
+    if (bestPrevious < 0 && active.empty() && rescue >= 0) {
+      // Nothing fits: accept an overfull line rather than losing the rest of the paragraph
+      bestPrevious = rescue;
+      best = nodes[rescue].demerits + KP_OVERFULL_DEMERITS;
+    }
+    if (bestPrevious < 0) {
+      return;
+    }
 
-      // Could not split: force at least one word per line to avoid infinite loop
-      if (currentIndex == lineStart) {
-        lineWidth += candidateWidth;
-        ++currentIndex;
+    nodes.push_back({best, nextStart, static_cast<uint16_t>(word), static_cast<uint16_t>(offset),
+                     bestPrevious, insertHyphen});
+    active.push_back(static_cast<int>(nodes.size() - 1));
+    rescue = -1;
+    if (isLast) {
+      finalNode = static_cast<int>(nodes.size() - 1);
+    }
+  };
+
+  int32_t wordStart = 0;
+  for (size_t w = windowStart; w < windowEnd; ++w) {
+    if (w > windowStart) {
+      wordStart += wordWidths[w - 1] + (continuesVec[w] ? 0 : spaceWidth);
+    }
+    const int32_t wordEnd = wordStart + wordWidths[w];
+
+    // Only words crossing the right edge of some line can usefully be split, which keeps trie lookups to about one
+    // word per line
+    const bool crossesEdge = std::any_of(active.begin(), active.end(), [&](const int node) {
+      return wordEnd - nodes[node].position > lineWidthFrom(node);
+    });
+    if (crossesEdge) {
+      seekWord(w);
+      const std::string& word = *cursor.word;
+      const auto style = *cursor.style;
+
+      // A word that cannot fit on any line may also break where no hyphenation rule allows it
+      const bool allowFallbackBreaks = wordWidths[w] > (w == 0 ? firstLineWidth : pageWidth);
+
+      std::vector<Hyphenator::BreakInfo> uncachedBreakInfos;
+      if (!breakCache) {
+        uncachedBreakInfos = Hyphenator::breakOffsets(word, allowFallbackBreaks);
+      }
+      const auto& breakInfos = breakCache ? breakCache->get(word, allowFallbackBreaks) : uncachedBreakInfos;
+
+      if (!breakInfos.empty()) {
+        renderer.getTextPrefixAdvances(fontId, word, style, prefixAdvances);
+        const int hyphenWidth = renderer.getTextAdvanceX(fontId, "-", style);
+        for (const auto& info : breakInfos) {
+          if (info.byteOffset == 0 || info.byteOffset >= word.size()) {
+            continue;
+          }
+          const int32_t splitAt = wordStart + prefixAdvances[info.byteOffset];
+          tryBreak(w, info.byteOffset, splitAt, info.requiresInsertedHyphen ? hyphenWidth : 0, splitAt,
+                   info.requiresInsertedHyphen, false);
+        }
       }
-      break;
     }
 
-    // Don't break before a continuation word (e.g., orphaned "?" after "question").
-    // Backtrack to the start of the continuation group so the whole group moves to the next line.
-    while (currentIndex > lineStart + 1 && currentIndex < wordWidths.size() && continuesVec[currentIndex]) {
-      --currentIndex;
+    // Break after the word, unless the next one attaches to it
+    const bool isLast = w + 1 == totalWordCount;
+    if (isLast || !continuesVec[w + 1]) {
+      tryBreak(w + 1, 0, wordEnd, 0, wordEnd + spaceWidth, false, isLast);
     }
+  }
+
+  // Pick the end of the path to commit
+  int endNode = finalNode;
+  if (windowEnd < totalWordCount) {
+    for (const int node : active) {
+      if (node != 0 && (endNode < 0 || nodes[node].demerits < nodes[endNode].demerits)) {
+        endNode = node;
+      }
+    }
+    if (endNode < 0 && rescue > 0) {
+      endNode = rescue;
+    }
+  }
+  if (endNode <= 0) {
+    return;
+  }
 
-    lineBreakIndices.push_back(currentIndex);
-    isFirstLine = false;
+  std::vector<int> path;
+  for (int node = endNode; node > 0; node = nodes[node].previous) {
+    path.push_back(node);
   }
+  std::reverse(path.begin(), path.end());
 
-  return lineBreakIndices;
+  size_t commitCount = path.size();
+  if (windowEnd < totalWordCount) {
+    commitCount = path.size() > KP_WINDOW_TAIL_LINES ? path.size() - KP_WINDOW_TAIL_LINES : 1;
+  }
+  for (size_t i = 0; i < commitCount; ++i) {
+    const BreakNode& node = nodes[path[i]];
+    breaks.push_back({node.word, node.offset, node.insertHyphen});
+  }
 }
 
 // Splits words[wordIndex] into prefix (adding a hyphen only when needed) and remainder when a legal breakpoint fits the
@@ -323,21 +533,24 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
     return false;
   }
 
-  // Get iterators to target word and style.
-  auto wordIt = words.begin();
-  auto styleIt = wordStyles.begin();
-  std::advance(wordIt, wordIndex);
-  std::advance(styleIt, wordIndex);
-
-  const std::string& word = *wordIt;
-  const auto style = *styleIt;
+  seekWord(wordIndex);
+  const std::string& word = *cursor.word;
+  const auto style = *cursor.style;
 
   // Collect candidate breakpoints (byte offsets and hyphen requirements).
-  auto breakInfos = Hyphenator::breakOffsets(word, allowFallbackBreaks);
+  std::vector<Hyphenator::BreakInfo> uncachedBreakInfos;
+  if (!breakCache) {
+    uncachedBreakInfos = Hyphenator::breakOffsets(word, allowFallbackBreaks);
+  }
+  const auto& breakInfos = breakCache ? breakCache->get(word, allowFallbackBreaks) : uncachedBreakInfos;
   if (breakInfos.empty()) {
     return false;
   }
 
+  // Measure the word once; every candidate prefix width is then a lookup instead of a re-measure.
+  renderer.getTextPrefixAdvances(fontId, word, style, prefixAdvances);
+  const int hyphenWidth = renderer.getTextAdvanceX(fontId, "-", style);
+
   size_t chosenOffset = 0;
   int chosenWidth = -1;
   bool chosenNeedsHyphen = true;
@@ -350,7 +563,7 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
     }
 
     const bool needsHyphen = info.requiresInsertedHyphen;
-    const int prefixWidth = measureWordWidth(renderer, fontId, word.substr(0, offset), style, needsHyphen);
+    const int prefixWidth = prefixAdvances[offset] + (needsHyphen ? hyphenWidth : 0);
     if (prefixWidth > availableWidth || prefixWidth <= chosenWidth) {
       continue;  // Skip if too wide or not an improvement
     }
@@ -365,28 +578,39 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
     return false;
   }
 
-  // Split the word at the selected breakpoint and append a hyphen if required.
-  std::string remainder = word.substr(chosenOffset);
-  wordIt->resize(chosenOffset);
-  if (chosenNeedsHyphen) {
+  // Glyph advances are additive, so the remainder width falls out of the same measurement.
+  const auto remainderWidth = static_cast<uint16_t>(prefixAdvances[word.size()] - prefixAdvances[chosenOffset]);
+
+  splitWordAt(wordIndex, chosenOffset, chosenNeedsHyphen, static_cast<uint16_t>(chosenWidth), remainderWidth,
+              wordWidths, continuesVec);
+  return true;
+}
+
+// Splits words[wordIndex] at a byte offset into prefix (adding a hyphen when requested) and remainder.
+void ParsedText::splitWordAt(const size_t wordIndex, const size_t offset, const bool insertHyphen,
+                             const uint16_t prefixWidth, const uint16_t remainderWidth,
+                             std::vector<uint16_t>& wordWidths, std::vector<bool>* continuesVec) {
+  seekWord(wordIndex);
+  const auto wordIt = cursor.word;
+  const auto styleIt = cursor.style;
+
+  std::string remainder = wordIt->substr(offset);
+  wordIt->resize(offset);
+  if (insertHyphen) {
     wordIt->push_back('-');
   }
 
   // Insert the remainder word (with matching style and continuation flag) directly after the prefix.
-  auto insertWordIt = std::next(wordIt);
-  auto insertStyleIt = std::next(styleIt);
-  words.insert(insertWordIt, remainder);
-  wordStyles.insert(insertStyleIt, style);
+  // List insertion leaves the cursor valid and still at wordIndex.
+  words.insert(std::next(wordIt), std::move(remainder));
+  wordStyles.insert(std::next(styleIt), *styleIt);
 
   // The remainder inherits whatever continuation status the original word had with the word after it.
-  // Find the continues entry for the original word and insert the remainder's entry after it.
-  auto continuesIt = wordContinues.begin();
-  std::advance(continuesIt, wordIndex);
+  const auto continuesIt = cursor.continues;
   const bool originalContinuedToNext = *continuesIt;
   // The original word (now prefix) does NOT continue to remainder (hyphen separates them)
   *continuesIt = false;
-  const auto insertContinuesIt = std::next(continuesIt);
-  wordContinues.insert(insertContinuesIt, originalContinuedToNext);
+  wordContinues.insert(std::next(continuesIt), originalContinuedToNext);
 
   // Keep the indexed vector in sync if provided
   if (continuesVec) {
@@ -395,10 +619,8 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
   }
 
   // Update cached widths to reflect the new prefix/remainder pairing.
-  wordWidths[wordIndex] = static_cast<uint16_t>(chosenWidth);
-  const uint16_t remainderWidth = measureWordWidth(renderer, fontId, remainder, style);
+  wordWidths[wordIndex] = prefixWidth;
   wordWidths.insert(wordWidths.begin() + wordIndex + 1, remainderWidth);
-  return true;
 }
 
 void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const int spaceWidth,
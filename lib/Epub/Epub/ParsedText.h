@@ -11,7 +11,9 @@
 #include "blocks/BlockStyle.h"
 #include "blocks/TextBlock.h"
 
+class BreakOffsetCache;
 class GfxRenderer;
+class WordWidthCache;
 
 class ParsedText {
   std::list<std::string> words;
@@ -20,13 +22,43 @@ class ParsedText {
   BlockStyle blockStyle;
   bool extraParagraphSpacing;
   bool hyphenationEnabled;
+  // Chapter-level caches, only set for the duration of layoutAndExtractLines
+  WordWidthCache* widthCache = nullptr;
+  BreakOffsetCache* breakCache = nullptr;
+
+  // Last word reached by index. Layout visits words in increasing order, so seeking from here is O(1) amortized
+  // where walking the lists from the front was O(n) per lookup.
+  struct WordCursor {
+    size_t index = 0;
+    std::list<std::string>::iterator word;
+    std::list<EpdFontFamily::Style>::iterator style;
+    std::list<bool>::iterator continues;
+  };
+  WordCursor cursor;
+  std::vector<uint16_t> prefixAdvances;  // Scratch buffer for word splitting
+
+  // A line break chosen by the optimal layout: the next line starts at byte offset of word (0 = word start)
+  struct LineBreak {
+    size_t word;
+    size_t offset;
+    bool insertHyphen;
+  };
+
+  void resetCursor();
+  void seekWord(size_t wordIndex);
 
   void applyParagraphIndent();
   std::vector<size_t> computeLineBreaks(const GfxRenderer& renderer, int fontId, int pageWidth, int spaceWidth,
                                         std::vector<uint16_t>& wordWidths, std::vector<bool>& continuesVec);
-  std::vector<size_t> computeHyphenatedLineBreaks(const GfxRenderer& renderer, int fontId, int pageWidth,
-                                                  int spaceWidth, std::vector<uint16_t>& wordWidths,
-                                                  std::vector<bool>& continuesVec);
+  std::vector<size_t> computeOptimalLineBreaks(const GfxRenderer& renderer, int fontId, int pageWidth, int spaceWidth,
+                                               std::vector<uint16_t>& wordWidths, std::vector<bool>& continuesVec);
+  void searchLineBreaks(const GfxRenderer& renderer, int fontId, int firstLineWidth, int pageWidth, int spaceWidth,
+                        size_t windowStart, const std::vector<uint16_t>& wordWidths,
+                        const std::vector<bool>& continuesVec, std::vector<LineBreak>& breaks);
+  void splitOversizedWords(const GfxRenderer& renderer, int fontId, int pageWidth, int firstLineIndent,
+                           std::vector<uint16_t>& wordWidths, std::vector<bool>& continuesVec);
+  void splitWordAt(size_t wordIndex, size_t offset, bool insertHyphen, uint16_t prefixWidth, uint16_t remainderWidth,
+                   std::vector<uint16_t>& wordWidths, std::vector<bool>* continuesVec);
   bool hyphenateWordAtIndex(size_t wordIndex, int availableWidth, const GfxRenderer& renderer, int fontId,
                             std::vector<uint16_t>& wordWidths, bool allowFallbackBreaks,
                             std::vector<bool>* continuesVec = nullptr);
@@ -48,5 +80,6 @@ class ParsedText {
   bool isEmpty() const { return words.empty(); }
   void layoutAndExtractLines(const GfxRenderer& renderer, int fontId, uint16_t viewportWidth,
                              const std::function<void(std::shared_ptr<TextBlock>)>& processLine,
-                             bool includeLastLine = true);
+                             bool includeLastLine = true, WordWidthCache* widthCache = nullptr,
+                             BreakOffsetCache* breakCache = nullptr);
 };
\ No newline at end of file
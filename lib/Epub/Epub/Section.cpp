@@ -2,6 +2,7 @@
 
 #include <HalStorage.h>
 #include <Logging.h>
+#include <PerfTrace.h>
 #include <Serialization.h>
 
 #include "Epub/css/CssParser.h"
@@ -22,6 +23,14 @@ uint32_t Section::onPageComplete(std::unique_ptr<Page> page) {
     return 0;
   }
 
+  if (collectingImages) {
+    for (const auto& element : page->elements) {
+      if (element->getTag() == TAG_PageImage) {
+        builtImages.push_back(std::static_pointer_cast<PageImage>(element));
+      }
+    }
+  }
+
   const uint32_t position = file.position();
   if (!page->serialize(file)) {
     LOG_ERR("SCT", "Failed to serialize page %d", pageCount);
@@ -110,6 +119,34 @@ bool Section::loadSectionFile(const int fontId, const float lineCompression, con
   return true;
 }
 
+// Drop every built section but this one (which is being written), so they are rebuilt on next open
+void Section::removeOtherSectionFiles() const {
+  const auto sectionsDir = epub->getCachePath() + "/sections";
+  FsFile dir = Storage.open(sectionsDir.c_str());
+  if (!dir || !dir.isDirectory()) {
+    if (dir) dir.close();
+    return;
+  }
+
+  const std::string ownName = std::to_string(spineIndex) + ".bin";
+  std::vector<std::string> stale;
+  char name[32];
+  for (FsFile entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+    entry.getName(name, sizeof(name));
+    const bool isDirectory = entry.isDirectory();
+    entry.close();
+    if (!isDirectory && ownName != name) {
+      stale.emplace_back(sectionsDir + "/" + name);
+    }
+  }
+  dir.close();
+
+  for (const auto& path : stale) {
+    Storage.remove(path.c_str());
+  }
+  LOG_DBG("SCT", "Removed %u sections built against a lost image manifest", static_cast<unsigned>(stale.size()));
+}
+
 // Your updated class method (assuming you are using the 'SD' object, which is a wrapper for a specific filesystem)
 bool Section::clearCache() const {
   if (!Storage.exists(filePath.c_str())) {
@@ -129,7 +166,10 @@ bool Section::clearCache() const {
 bool Section::createSectionFile(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
                                 const uint8_t paragraphAlignment, const uint16_t viewportWidth,
                                 const uint16_t viewportHeight, const bool hyphenationEnabled, const bool embeddedStyle,
-                                const std::function<void()>& popupFn) {
+                                const std::function<void()>& popupFn, const bool collectImages) {
+  perf::Scope perfScope(perf::Metric::SECTION_BUILD);
+  builtImages.clear();
+  collectingImages = collectImages;
   const auto localPath = epub->getSpineItem(spineIndex).href;
   const auto tmpHtmlPath = epub->getCachePath() + "/.tmp_" + std::to_string(spineIndex) + ".html";
 
@@ -182,10 +222,16 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
                          viewportHeight, hyphenationEnabled, embeddedStyle);
   std::vector<uint32_t> lut = {};
 
-  // Derive the content base directory and image cache path prefix for the parser
+  // Derive the content base directory for the parser
   size_t lastSlash = localPath.find_last_of('/');
   std::string contentBase = (lastSlash != std::string::npos) ? localPath.substr(0, lastSlash + 1) : "";
-  std::string imageBasePath = epub->getCachePath() + "/img_" + std::to_string(spineIndex) + "_";
+
+  // Images are extracted once per book and shared across sections through the manifest
+  ImageManifest* imageManifest = epub->getImageManifest();
+  if (imageManifest->load() && imageManifest->getPrunedCount() > 0) {
+    // The manifest was started fresh, other built sections may point at the images it just pruned
+    removeOtherSectionFiles();
+  }
 
   CssParser* cssParser = nullptr;
   if (embeddedStyle) {
@@ -201,10 +247,15 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
       epub, tmpHtmlPath, renderer, fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
       viewportHeight, hyphenationEnabled,
       [this, &lut](std::unique_ptr<Page> page) { lut.emplace_back(this->onPageComplete(std::move(page))); },
-      embeddedStyle, contentBase, imageBasePath, popupFn, cssParser);
+      embeddedStyle, contentBase, *imageManifest, popupFn, cssParser);
   Hyphenator::setPreferredLanguage(epub->getLanguage());
   success = visitor.parseAndBuildPages();
 
+  // Persist newly extracted images even if the parse failed, they stay valid for the next attempt
+  if (!imageManifest->save()) {
+    LOG_ERR("SCT", "Failed to save image manifest");
+  }
+
   Storage.remove(tmpHtmlPath.c_str());
   if (!success) {
     LOG_ERR("SCT", "Failed to parse XML and build pages");
@@ -239,13 +290,27 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
   serialization::writePod(file, pageCount);
   serialization::writePod(file, lutOffset);
   file.close();
+  perf::count(perf::Counter::SECTION_PAGES, pageCount);
   if (cssParser) {
     cssParser->clear();
   }
   return true;
 }
 
+void Section::prerenderImages(const int xOffset, const int yOffset) {
+  int cached = 0;
+  for (const auto& image : builtImages) {
+    if (image->prerender(renderer, xOffset, yOffset)) {
+      cached++;
+    }
+  }
+  LOG_DBG("SCT", "Pre-rendered %d of %d images", cached, builtImages.size());
+  builtImages.clear();
+  builtImages.shrink_to_fit();
+}
+
 std::unique_ptr<Page> Section::loadPageFromSectionFile() {
+  perf::Scope perfScope(perf::Metric::PAGE_LOAD);
   if (!Storage.openFileForRead("SCT", filePath, file)) {
     return nullptr;
   }
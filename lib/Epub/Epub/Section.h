@@ -1,10 +1,12 @@
 #pragma once
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "Epub.h"
 
 class Page;
+class PageImage;
 class GfxRenderer;
 
 class Section {
@@ -13,11 +15,14 @@ class Section {
   GfxRenderer& renderer;
   std::string filePath;
   FsFile file;
+  std::vector<std::shared_ptr<PageImage>> builtImages;  // Placed by the last createSectionFile, for prerenderImages
+  bool collectingImages = false;                        // The running createSectionFile fills builtImages
 
   void writeSectionFileHeader(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
                               uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled,
                               bool embeddedStyle);
   uint32_t onPageComplete(std::unique_ptr<Page> page);
+  void removeOtherSectionFiles() const;
 
  public:
   uint16_t pageCount = 0;
@@ -34,6 +39,10 @@ class Section {
   bool clearCache() const;
   bool createSectionFile(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
                          uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled, bool embeddedStyle,
-                         const std::function<void()>& popupFn = nullptr);
+                         const std::function<void()>& popupFn = nullptr, bool collectImages = false);
   std::unique_ptr<Page> loadPageFromSectionFile();
+  // Decode the images of the section just built into their pixel caches, for pages drawn at this origin, so page
+  // turns never run an image decoder, also for an image placed on several pages. Runs after the parser and CSS are
+  // freed, and only sees the images of a build that was asked to collect them.
+  void prerenderImages(int xOffset, int yOffset);
 };
@@ -0,0 +1,115 @@
+#include "WordWidthCache.h"
+
+#include <Logging.h>
+#include <MemoryBudget.h>
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace {
+// FNV-1a over the key, 32 bits are plenty for picking a set
+uint32_t hashKey(const int fontId, const uint8_t style, const std::string& word) {
+  uint32_t hash = 2166136261u;
+  const auto mix = [&hash](const uint8_t byte) {
+    hash ^= byte;
+    hash *= 16777619u;
+  };
+  for (const char c : word) {
+    mix(static_cast<uint8_t>(c));
+  }
+  mix(style);
+  for (int shift = 0; shift < 32; shift += 8) {
+    mix(static_cast<uint8_t>(static_cast<uint32_t>(fontId) >> shift));
+  }
+  return hash;
+}
+}  // namespace
+
+WordWidthCache::WordWidthCache() {
+  constexpr size_t tableBytes = sizeof(Entry) * SET_COUNT * WAYS;
+  if (!MemBudget.tryReserve(MemoryBudget::Consumer::WORD_CACHE, tableBytes)) {
+    LOG_DBG("WWC", "No budget for word width cache, measuring every word");
+    return;
+  }
+  entries.reset(new (std::nothrow) Entry[SET_COUNT * WAYS]);
+  if (!entries) {
+    MemBudget.release(MemoryBudget::Consumer::WORD_CACHE, tableBytes);
+    LOG_ERR("WWC", "Failed to allocate word width cache, measuring every word");
+    return;
+  }
+  memset(entries.get(), 0, tableBytes);
+  // Only a speed-up, the whole table goes when anything more important needs the memory
+  MemBudget.setPressureCallback(
+      MemoryBudget::Consumer::WORD_CACHE,
+      [](void* context, size_t) { static_cast<WordWidthCache*>(context)->freeTable(); }, this);
+}
+
+WordWidthCache::~WordWidthCache() { freeTable(); }
+
+void WordWidthCache::freeTable() {
+  if (!entries) {
+    return;
+  }
+  MemBudget.setPressureCallback(MemoryBudget::Consumer::WORD_CACHE, nullptr, nullptr);
+  entries.reset();
+  MemBudget.release(MemoryBudget::Consumer::WORD_CACHE, sizeof(Entry) * SET_COUNT * WAYS);
+}
+
+WordWidthCache::Entry* WordWidthCache::setFor(const int fontId, const EpdFontFamily::Style style,
+                                              const std::string& word) const {
+  if (!entries || word.empty() || word.size() > MAX_WORD_BYTES) {
+    return nullptr;
+  }
+  return &entries[(hashKey(fontId, style, word) & (SET_COUNT - 1)) * WAYS];
+}
+
+bool WordWidthCache::find(const int fontId, const EpdFontFamily::Style style, const std::string& word,
+                          uint16_t& width) {
+  Entry* set = setFor(fontId, style, word);
+  if (!set) {
+    misses++;
+    return false;
+  }
+
+  for (size_t way = 0; way < WAYS; way++) {
+    const Entry& entry = set[way];
+    if (entry.length == word.size() && entry.fontId == fontId && entry.style == style &&
+        memcmp(entry.word, word.data(), entry.length) == 0) {
+      width = entry.width;
+      // Keep the most recently used entry in way 0
+      if (way > 0) {
+        std::swap(set[0], set[way]);
+      }
+      hits++;
+      return true;
+    }
+  }
+  misses++;
+  return false;
+}
+
+void WordWidthCache::put(const int fontId, const EpdFontFamily::Style style, const std::string& word,
+                         const uint16_t width) {
+  Entry* set = setFor(fontId, style, word);
+  if (!set) {
+    return;
+  }
+
+  // Evict the least recently used way and insert as most recent
+  for (size_t way = WAYS - 1; way > 0; way--) {
+    set[way] = set[way - 1];
+  }
+  Entry& entry = set[0];
+  entry.fontId = fontId;
+  entry.width = width;
+  entry.style = style;
+  entry.length = static_cast<uint8_t>(word.size());
+  memcpy(entry.word, word.data(), word.size());
+}
+
+void WordWidthCache::logStats(const char* origin) const {
+  const uint32_t lookups = hits + misses;
+  LOG_DBG(origin, "Word width cache: %lu hits / %lu lookups (%lu%%)", static_cast<unsigned long>(hits),
+          static_cast<unsigned long>(lookups), static_cast<unsigned long>(lookups ? hits * 100ull / lookups : 0));
+}
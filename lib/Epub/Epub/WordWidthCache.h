@@ -0,0 +1,54 @@
+#pragma once
+
+#include <EpdFontFamily.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Bounded memo of word advance widths, keyed by (font, style, word bytes).
+ *
+ * Prose repeats the same few thousand words, so measuring each occurrence through GfxRenderer (font lookup, UTF-8
+ * decoding and a glyph lookup per codepoint) is mostly wasted work during chapter indexing. The table is a fixed
+ * 2-way set-associative array with LRU replacement inside each set. Words are stored inline for exact matching;
+ * longer words are rare and skip the cache. The table is reserved under the memory budget and dropped under memory
+ * pressure; without it every lookup is a miss.
+ */
+class WordWidthCache {
+ public:
+  // Longest word (in bytes) stored in the cache
+  static constexpr size_t MAX_WORD_BYTES = 24;
+
+  WordWidthCache();
+  ~WordWidthCache();
+  WordWidthCache(const WordWidthCache&) = delete;
+  WordWidthCache& operator=(const WordWidthCache&) = delete;
+
+  // Returns true and sets width if the word was measured before with the same font and style
+  bool find(int fontId, EpdFontFamily::Style style, const std::string& word, uint16_t& width);
+  void put(int fontId, EpdFontFamily::Style style, const std::string& word, uint16_t width);
+
+  uint32_t getHits() const { return hits; }
+  uint32_t getMisses() const { return misses; }
+  void logStats(const char* origin) const;
+
+ private:
+  static constexpr size_t SET_COUNT = 256;
+  static constexpr size_t WAYS = 2;
+
+  struct Entry {
+    int32_t fontId;
+    uint16_t width;
+    uint8_t style;
+    uint8_t length;  // 0 = empty slot
+    char word[MAX_WORD_BYTES];
+  };
+
+  std::unique_ptr<Entry[]> entries;
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+
+  Entry* setFor(int fontId, EpdFontFamily::Style style, const std::string& word) const;
+  void freeTable();
+};
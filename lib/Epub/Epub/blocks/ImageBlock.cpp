@@ -5,13 +5,11 @@
 #include <SDCardManager.h>
 #include <Serialization.h>
 
-#include "../converters/DitherUtils.h"
 #include "../converters/ImageDecoderFactory.h"
+#include "../converters/PixelCacheLayout.h"
 
-// Cache file format:
-// - uint16_t width
-// - uint16_t height
-// - uint8_t pixels[...] - 2 bits per pixel, packed (4 pixels per byte), row-major order
+// Decoded images are cached next to the source as a FramebufferImageCache (.pxc): the BW, LSB and MSB planes,
+// pre-rotated for the orientation and position they were decoded at, one file per placement.
 
 ImageBlock::ImageBlock(const std::string& imagePath, int16_t width, int16_t height)
     : imagePath(imagePath), width(width), height(height) {}
@@ -20,111 +18,95 @@ bool ImageBlock::imageExists() const { return Storage.exists(imagePath.c_str());
 
 namespace {
 
-std::string getCachePath(const std::string& imagePath) {
-  // Replace extension with .pxc (pixel cache)
-  size_t dotPos = imagePath.rfind('.');
-  if (dotPos != std::string::npos) {
-    return imagePath.substr(0, dotPos) + ".pxc";
-  }
-  return imagePath + ".pxc";
+std::string getCachePath(const std::string& imagePath, const GfxRenderer& renderer, const int x, const int y) {
+  return pixel_cache::pathFor(imagePath, x, y, renderer.getOrientation());
 }
 
-bool renderFromCache(GfxRenderer& renderer, const std::string& cachePath, int x, int y, int expectedWidth,
-                     int expectedHeight) {
-  FsFile cacheFile;
-  if (!Storage.openFileForRead("IMG", cachePath, cacheFile)) {
-    return false;
-  }
-
-  uint16_t cachedWidth, cachedHeight;
-  if (cacheFile.read(&cachedWidth, 2) != 2 || cacheFile.read(&cachedHeight, 2) != 2) {
-    cacheFile.close();
-    return false;
-  }
-
-  // Verify dimensions are close (allow 1 pixel tolerance for rounding differences)
-  int widthDiff = abs(cachedWidth - expectedWidth);
-  int heightDiff = abs(cachedHeight - expectedHeight);
-  if (widthDiff > 1 || heightDiff > 1) {
-    LOG_ERR("IMG", "Cache dimension mismatch: %dx%d vs %dx%d", cachedWidth, cachedHeight, expectedWidth,
-            expectedHeight);
-    cacheFile.close();
-    return false;
-  }
-
-  // Use cached dimensions for rendering (they're the actual decoded size)
-  expectedWidth = cachedWidth;
-  expectedHeight = cachedHeight;
-
-  LOG_DBG("IMG", "Loading from cache: %s (%dx%d)", cachePath.c_str(), cachedWidth, cachedHeight);
-
-  // Read and render row by row to minimize memory usage
-  const int bytesPerRow = (cachedWidth + 3) / 4;  // 2 bits per pixel, 4 pixels per byte
-  uint8_t* rowBuffer = (uint8_t*)malloc(bytesPerRow);
-  if (!rowBuffer) {
-    LOG_ERR("IMG", "Failed to allocate row buffer");
-    cacheFile.close();
-    return false;
-  }
-
-  for (int row = 0; row < cachedHeight; row++) {
-    if (cacheFile.read(rowBuffer, bytesPerRow) != bytesPerRow) {
-      LOG_ERR("IMG", "Cache read error at row %d", row);
-      free(rowBuffer);
-      cacheFile.close();
-      return false;
-    }
-
-    int destY = y + row;
-    for (int col = 0; col < cachedWidth; col++) {
-      int byteIdx = col / 4;
-      int bitShift = 6 - (col % 4) * 2;  // MSB first within byte
-      uint8_t pixelValue = (rowBuffer[byteIdx] >> bitShift) & 0x03;
-
-      drawPixelWithRenderMode(renderer, x + col, destY, pixelValue);
-    }
+FramebufferImageCache::Plane planeForRenderMode(const GfxRenderer::RenderMode mode) {
+  switch (mode) {
+    case GfxRenderer::GRAYSCALE_LSB:
+      return FramebufferImageCache::GRAYSCALE_LSB_PLANE;
+    case GfxRenderer::GRAYSCALE_MSB:
+      return FramebufferImageCache::GRAYSCALE_MSB_PLANE;
+    default:
+      return FramebufferImageCache::BW_PLANE;
   }
-
-  free(rowBuffer);
-  cacheFile.close();
-  LOG_DBG("IMG", "Cache render complete");
-  return true;
 }
 
 }  // namespace
 
-void ImageBlock::render(GfxRenderer& renderer, const int x, const int y) {
-  LOG_DBG("IMG", "Rendering image at %d,%d: %s (%dx%d)", x, y, imagePath.c_str(), width, height);
-
+bool ImageBlock::fitsScreen(const GfxRenderer& renderer, const int x, const int y) const {
   const int screenWidth = renderer.getScreenWidth();
   const int screenHeight = renderer.getScreenHeight();
 
-  // Bounds check render position using logical screen dimensions
-  if (x < 0 || y < 0 || x + width > screenWidth || y + height > screenHeight) {
+  // The origin must be on screen, anything running past the right or bottom edge is clipped
+  if (x < 0 || y < 0 || x >= screenWidth || y >= screenHeight || width <= 0 || height <= 0) {
     LOG_ERR("IMG", "Invalid render position: (%d,%d) size (%dx%d) screen (%dx%d)", x, y, width, height, screenWidth,
             screenHeight);
-    return;
+    return false;
   }
+  return true;
+}
 
-  // Try to render from cache first
-  std::string cachePath = getCachePath(imagePath);
-  if (renderFromCache(renderer, cachePath, x, y, width, height)) {
-    return;  // Successfully rendered from cache
+std::unique_ptr<FramebufferImageCache> ImageBlock::openCache(const GfxRenderer& renderer, const int x,
+                                                             const int y) const {
+  std::unique_ptr<FramebufferImageCache> cache(
+      new FramebufferImageCache(renderer, getCachePath(imagePath, renderer, x, y)));
+  if (!cache->open()) {
+    return nullptr;
+  }
+  // The file is per position, the rect guards against a size change. It holds the on-screen part of the image, allow
+  // 1 pixel tolerance on size for rounding.
+  int visibleX = x;
+  int visibleY = y;
+  int visibleWidth = width;
+  int visibleHeight = height;
+  pixel_cache::clipToScreen(visibleX, visibleY, visibleWidth, visibleHeight, renderer.getScreenWidth(),
+                            renderer.getScreenHeight());
+  if (cache->getX() != visibleX || cache->getY() != visibleY || abs(cache->getWidth() - visibleWidth) > 1 ||
+      abs(cache->getHeight() - visibleHeight) > 1) {
+    LOG_ERR("IMG", "Cache rect mismatch: %d,%d %dx%d vs %d,%d %dx%d", cache->getX(), cache->getY(), cache->getWidth(),
+            cache->getHeight(), visibleX, visibleY, visibleWidth, visibleHeight);
+    return nullptr;
   }
+  return cache;
+}
 
-  // No cache - need to decode the image
+bool ImageBlock::renderFromCache(GfxRenderer& renderer, const int x, const int y) {
+  const auto plane = planeForRenderMode(renderer.getRenderMode());
+  if (pixelCache && (pixelCache->getX() != x || pixelCache->getY() != y)) {
+    pixelCache.reset();  // Planes held for another placement
+  }
+  if (pixelCache) {
+    return pixelCache->drawPlane(plane);
+  }
+
+  auto cache = openCache(renderer, x, y);
+  if (!cache) {
+    return false;
+  }
+  LOG_DBG("IMG", "Loading from cache: %s (%dx%d)", imagePath.c_str(), cache->getWidth(), cache->getHeight());
+  if (!cache->loadPlanes()) {
+    // Not enough memory to keep it, draw straight from the file and let it close
+    return cache->drawPlane(plane);
+  }
+  pixelCache = std::move(cache);
+  return pixelCache->drawPlane(plane);
+}
+
+bool ImageBlock::decode(GfxRenderer& renderer, const int x, const int y, const bool draw) const {
   // Check if image file exists
   FsFile file;
   if (!Storage.openFileForRead("IMG", imagePath, file)) {
     LOG_ERR("IMG", "Image file not found: %s", imagePath.c_str());
-    return;
+    return false;
   }
   size_t fileSize = file.size();
   file.close();
 
   if (fileSize == 0) {
     LOG_ERR("IMG", "Image file is empty: %s", imagePath.c_str());
-    return;
+    return false;
   }
 
   LOG_DBG("IMG", "Decoding and caching: %s", imagePath.c_str());
@@ -138,23 +120,50 @@ void ImageBlock::render(GfxRenderer& renderer, const int x, const int y) {
   config.useDithering = true;
   config.performanceMode = false;
   config.useExactDimensions = true;  // Use pre-calculated dimensions to avoid rounding mismatches
-  config.cachePath = cachePath;      // Enable caching during decode
+  config.cachePath = getCachePath(imagePath, renderer, x, y);  // Enable caching during decode
+  config.drawToFramebuffer = draw;
 
   ImageToFramebufferDecoder* decoder = ImageDecoderFactory::getDecoder(imagePath);
   if (!decoder) {
     LOG_ERR("IMG", "No decoder found for image: %s", imagePath.c_str());
-    return;
+    return false;
   }
 
   LOG_DBG("IMG", "Using %s decoder", decoder->getFormatName());
 
-  bool success = decoder->decodeToFramebuffer(imagePath, renderer, config);
-  if (!success) {
+  if (!decoder->decodeToFramebuffer(imagePath, renderer, config)) {
     LOG_ERR("IMG", "Failed to decode image: %s", imagePath.c_str());
-    return;
+    return false;
   }
 
   LOG_DBG("IMG", "Decode successful");
+  return true;
+}
+
+void ImageBlock::render(GfxRenderer& renderer, const int x, const int y) {
+  LOG_DBG("IMG", "Rendering image at %d,%d: %s (%dx%d)", x, y, imagePath.c_str(), width, height);
+
+  if (!fitsScreen(renderer, x, y)) {
+    return;
+  }
+
+  // Try to render from cache first
+  if (renderFromCache(renderer, x, y)) {
+    return;  // Successfully rendered from cache
+  }
+
+  // No cache - need to decode the image
+  decode(renderer, x, y, true);
+}
+
+bool ImageBlock::prerender(GfxRenderer& renderer, const int x, const int y) const {
+  if (!fitsScreen(renderer, x, y)) {
+    return false;
+  }
+  if (openCache(renderer, x, y)) {
+    return true;  // Already cached for this position, e.g. shared with another section
+  }
+  return decode(renderer, x, y, false);
 }
 
 bool ImageBlock::serialize(FsFile& file) {
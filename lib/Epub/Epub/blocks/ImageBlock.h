@@ -1,4 +1,5 @@
 #pragma once
+#include <FramebufferImageCache.h>
 #include <SdFat.h>
 
 #include <memory>
@@ -21,6 +22,9 @@ class ImageBlock final : public Block {
   bool isEmpty() override { return false; }
 
   void render(GfxRenderer& renderer, const int x, const int y);
+  // Decode into the pixel cache only, so the first render at this position copies planes instead of decoding. Each
+  // position and orientation has its own cache file, so placements of a shared image don't evict each other.
+  bool prerender(GfxRenderer& renderer, int x, int y) const;
   bool serialize(FsFile& file);
   static std::unique_ptr<ImageBlock> deserialize(FsFile& file);
 
@@ -28,4 +32,11 @@ class ImageBlock final : public Block {
   std::string imagePath;
   int16_t width;
   int16_t height;
+  // Planes loaded on the first render pass of a page, so the grayscale passes don't go back to the SD card
+  std::unique_ptr<FramebufferImageCache> pixelCache;
+
+  bool fitsScreen(const GfxRenderer& renderer, int x, int y) const;
+  std::unique_ptr<FramebufferImageCache> openCache(const GfxRenderer& renderer, int x, int y) const;
+  bool renderFromCache(GfxRenderer& renderer, int x, int y);
+  bool decode(GfxRenderer& renderer, int x, int y, bool draw) const;
 };
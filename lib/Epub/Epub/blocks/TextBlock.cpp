@@ -4,6 +4,8 @@
 #include <Logging.h>
 #include <Serialization.h>
 
+#include <vector>
+
 void TextBlock::render(const GfxRenderer& renderer, const int fontId, const int x, const int y) const {
   // Validate iterator bounds before rendering
   if (words.size() != wordXpos.size() || words.size() != wordStyles.size()) {
@@ -12,13 +14,23 @@ void TextBlock::render(const GfxRenderer& renderer, const int fontId, const int
     return;
   }
 
+  // Draw the whole line at once so mixed styles do not thrash the glyph decompression cache
+  std::vector<GfxRenderer::TextRun> runs;
+  runs.reserve(words.size());
   auto wordIt = words.begin();
   auto wordStylesIt = wordStyles.begin();
   auto wordXposIt = wordXpos.begin();
+  for (size_t i = 0; i < words.size(); i++, ++wordIt, ++wordStylesIt, ++wordXposIt) {
+    runs.push_back({*wordXposIt + x, wordIt->c_str(), *wordStylesIt});
+  }
+  renderer.drawTextLine(fontId, y, runs.data(), runs.size());
+
+  wordIt = words.begin();
+  wordStylesIt = wordStyles.begin();
+  wordXposIt = wordXpos.begin();
   for (size_t i = 0; i < words.size(); i++) {
     const int wordX = *wordXposIt + x;
     const EpdFontFamily::Style currentStyle = *wordStylesIt;
-    renderer.drawText(fontId, wordX, y, wordIt->c_str(), true, currentStyle);
 
     if ((currentStyle & EpdFontFamily::UNDERLINE) != 0) {
       const std::string& w = *wordIt;
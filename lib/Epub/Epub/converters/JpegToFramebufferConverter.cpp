@@ -12,6 +12,20 @@
 #include "DitherUtils.h"
 #include "PixelCache.h"
 
+namespace {
+// Largest picojpeg reduction (1/8, 1/4 or 1/2) that still leaves at least the destination size, as a shift
+int chooseReduceShift(const int srcWidth, const int srcHeight, const int destWidth, const int destHeight) {
+  for (int shift = 3; shift > 0; shift--) {
+    if ((srcWidth >> shift) >= destWidth && (srcHeight >> shift) >= destHeight) {
+      return shift;
+    }
+  }
+  return 0;
+}
+
+constexpr unsigned char REDUCE_FOR_SHIFT[] = {PJPG_SCALE_FULL, PJPG_SCALE_1_2, PJPG_SCALE_1_4, PJPG_SCALE_1_8};
+}  // namespace
+
 struct JpegContext {
   FsFile& file;
   uint8_t buffer[512];
@@ -93,8 +107,24 @@ bool JpegToFramebufferConverter::decodeToFramebuffer(const std::string& imagePat
     destHeight = (int)(imageInfo.m_height * scale);
   }
 
-  LOG_DBG("JPG", "JPEG %dx%d -> %dx%d (scale %.2f), scan type: %d, MCU: %dx%d", imageInfo.m_width, imageInfo.m_height,
-          destWidth, destHeight, scale, imageInfo.m_scanType, imageInfo.m_MCUWidth, imageInfo.m_MCUHeight);
+  // Decode straight at 1/2, 1/4 or 1/8 size when the image is scaled down that far anyway
+  const int reduceShift = chooseReduceShift(imageInfo.m_width, imageInfo.m_height, destWidth, destHeight);
+  if (reduceShift > 0) {
+    file.seek(0);
+    context.bufferPos = 0;
+    context.bufferFilled = 0;
+    status = pjpeg_decode_init(&imageInfo, jpegReadCallback, &context, REDUCE_FOR_SHIFT[reduceShift]);
+    if (status != 0) {
+      LOG_ERR("JPG", "picojpeg reduced init failed: %d", status);
+      file.close();
+      return false;
+    }
+    scale *= 1 << reduceShift;
+  }
+
+  LOG_DBG("JPG", "JPEG %dx%d -> %dx%d (scale %.2f, reduce 1/%d), scan type: %d, MCU: %dx%d", imageInfo.m_width,
+          imageInfo.m_height, destWidth, destHeight, scale, 1 << reduceShift, imageInfo.m_scanType,
+          imageInfo.m_MCUWidth, imageInfo.m_MCUHeight);
 
   if (!imageInfo.m_pMCUBufR || !imageInfo.m_pMCUBufG || !imageInfo.m_pMCUBufB) {
     LOG_ERR("JPG", "Null buffer pointers in imageInfo");
@@ -114,6 +144,16 @@ bool JpegToFramebufferConverter::decodeToFramebuffer(const std::string& imagePat
       caching = false;
     }
   }
+  if (!caching && !config.drawToFramebuffer) {
+    file.close();
+    return false;
+  }
+
+  // Valid pixels per 8x8 block side and per MCU, in decoded (reduced) pixels
+  const int blockSize = 8 >> reduceShift;
+  const int mcuWidth = imageInfo.m_MCUWidth >> reduceShift;
+  const int mcuHeight = imageInfo.m_MCUHeight >> reduceShift;
+  const bool grayscale = imageInfo.m_scanType == PJPG_GRAYSCALE;
 
   int mcuX = 0;
   int mcuY = 0;
@@ -129,121 +169,32 @@ bool JpegToFramebufferConverter::decodeToFramebuffer(const std::string& imagePat
       return false;
     }
 
-    // Source position in image coordinates
-    int srcStartX = mcuX * imageInfo.m_MCUWidth;
-    int srcStartY = mcuY * imageInfo.m_MCUHeight;
-
-    switch (imageInfo.m_scanType) {
-      case PJPG_GRAYSCALE:
-        for (int row = 0; row < 8; row++) {
-          int srcY = srcStartY + row;
-          int destY = config.y + (int)(srcY * scale);
-          if (destY >= screenHeight || destY >= config.y + destHeight) continue;
-          for (int col = 0; col < 8; col++) {
-            int srcX = srcStartX + col;
-            int destX = config.x + (int)(srcX * scale);
-            if (destX >= screenWidth || destX >= config.x + destWidth) continue;
-            uint8_t gray = imageInfo.m_pMCUBufR[row * 8 + col];
-            uint8_t dithered = config.useDithering ? applyBayerDither4Level(gray, destX, destY) : gray / 85;
-            if (dithered > 3) dithered = 3;
-            drawPixelWithRenderMode(renderer, destX, destY, dithered);
-            if (caching) cache.setPixel(destX, destY, dithered);
-          }
-        }
-        break;
-
-      case PJPG_YH1V1:
-        for (int row = 0; row < 8; row++) {
-          int srcY = srcStartY + row;
-          int destY = config.y + (int)(srcY * scale);
-          if (destY >= screenHeight || destY >= config.y + destHeight) continue;
-          for (int col = 0; col < 8; col++) {
-            int srcX = srcStartX + col;
-            int destX = config.x + (int)(srcX * scale);
-            if (destX >= screenWidth || destX >= config.x + destWidth) continue;
-            uint8_t r = imageInfo.m_pMCUBufR[row * 8 + col];
-            uint8_t g = imageInfo.m_pMCUBufG[row * 8 + col];
-            uint8_t b = imageInfo.m_pMCUBufB[row * 8 + col];
-            uint8_t gray = (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);
-            uint8_t dithered = config.useDithering ? applyBayerDither4Level(gray, destX, destY) : gray / 85;
-            if (dithered > 3) dithered = 3;
-            drawPixelWithRenderMode(renderer, destX, destY, dithered);
-            if (caching) cache.setPixel(destX, destY, dithered);
-          }
-        }
-        break;
-
-      case PJPG_YH2V1:
-        for (int row = 0; row < 8; row++) {
-          int srcY = srcStartY + row;
-          int destY = config.y + (int)(srcY * scale);
-          if (destY >= screenHeight || destY >= config.y + destHeight) continue;
-          for (int col = 0; col < 16; col++) {
-            int srcX = srcStartX + col;
-            int destX = config.x + (int)(srcX * scale);
-            if (destX >= screenWidth || destX >= config.x + destWidth) continue;
-            int blockIndex = (col < 8) ? 0 : 1;
-            int pixelIndex = row * 8 + (col % 8);
-            uint8_t r = imageInfo.m_pMCUBufR[blockIndex * 64 + pixelIndex];
-            uint8_t g = imageInfo.m_pMCUBufG[blockIndex * 64 + pixelIndex];
-            uint8_t b = imageInfo.m_pMCUBufB[blockIndex * 64 + pixelIndex];
-            uint8_t gray = (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);
-            uint8_t dithered = config.useDithering ? applyBayerDither4Level(gray, destX, destY) : gray / 85;
-            if (dithered > 3) dithered = 3;
-            drawPixelWithRenderMode(renderer, destX, destY, dithered);
-            if (caching) cache.setPixel(destX, destY, dithered);
-          }
-        }
-        break;
-
-      case PJPG_YH1V2:
-        for (int row = 0; row < 16; row++) {
-          int srcY = srcStartY + row;
-          int destY = config.y + (int)(srcY * scale);
-          if (destY >= screenHeight || destY >= config.y + destHeight) continue;
-          for (int col = 0; col < 8; col++) {
-            int srcX = srcStartX + col;
-            int destX = config.x + (int)(srcX * scale);
-            if (destX >= screenWidth || destX >= config.x + destWidth) continue;
-            int blockIndex = (row < 8) ? 0 : 1;
-            int pixelIndex = (row % 8) * 8 + col;
-            uint8_t r = imageInfo.m_pMCUBufR[blockIndex * 128 + pixelIndex];
-            uint8_t g = imageInfo.m_pMCUBufG[blockIndex * 128 + pixelIndex];
-            uint8_t b = imageInfo.m_pMCUBufB[blockIndex * 128 + pixelIndex];
-            uint8_t gray = (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);
-            uint8_t dithered = config.useDithering ? applyBayerDither4Level(gray, destX, destY) : gray / 85;
-            if (dithered > 3) dithered = 3;
-            drawPixelWithRenderMode(renderer, destX, destY, dithered);
-            if (caching) cache.setPixel(destX, destY, dithered);
-          }
-        }
-        break;
-
-      case PJPG_YH2V2:
-        for (int row = 0; row < 16; row++) {
-          int srcY = srcStartY + row;
-          int destY = config.y + (int)(srcY * scale);
-          if (destY >= screenHeight || destY >= config.y + destHeight) continue;
-          for (int col = 0; col < 16; col++) {
-            int srcX = srcStartX + col;
-            int destX = config.x + (int)(srcX * scale);
-            if (destX >= screenWidth || destX >= config.x + destWidth) continue;
-            int blockX = (col < 8) ? 0 : 1;
-            int blockY = (row < 8) ? 0 : 1;
-            int blockIndex = blockY * 2 + blockX;
-            int pixelIndex = (row % 8) * 8 + (col % 8);
-            int blockOffset = blockIndex * 64;
-            uint8_t r = imageInfo.m_pMCUBufR[blockOffset + pixelIndex];
-            uint8_t g = imageInfo.m_pMCUBufG[blockOffset + pixelIndex];
-            uint8_t b = imageInfo.m_pMCUBufB[blockOffset + pixelIndex];
-            uint8_t gray = (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);
-            uint8_t dithered = config.useDithering ? applyBayerDither4Level(gray, destX, destY) : gray / 85;
-            if (dithered > 3) dithered = 3;
-            drawPixelWithRenderMode(renderer, destX, destY, dithered);
-            if (caching) cache.setPixel(destX, destY, dithered);
-          }
+    // Source position in decoded image coordinates
+    const int srcStartX = mcuX * mcuWidth;
+    const int srcStartY = mcuY * mcuHeight;
+
+    for (int row = 0; row < mcuHeight; row++) {
+      const int destY = config.y + (int)((srcStartY + row) * scale);
+      if (destY >= screenHeight || destY >= config.y + destHeight) continue;
+      for (int col = 0; col < mcuWidth; col++) {
+        const int destX = config.x + (int)((srcStartX + col) * scale);
+        if (destX >= screenWidth || destX >= config.x + destWidth) continue;
+        // Blocks sit at byte offsets 0, 64 (right), 128 (below) and 192 in picojpeg's MCU buffers
+        const int offset = (row / blockSize) * 128 + (col / blockSize) * 64 + (row % blockSize) * 8 + col % blockSize;
+        uint8_t gray;
+        if (grayscale) {
+          gray = imageInfo.m_pMCUBufR[offset];
+        } else {
+          const uint8_t r = imageInfo.m_pMCUBufR[offset];
+          const uint8_t g = imageInfo.m_pMCUBufG[offset];
+          const uint8_t b = imageInfo.m_pMCUBufB[offset];
+          gray = (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);
         }
-        break;
+        uint8_t dithered = config.useDithering ? applyBayerDither4Level(gray, destX, destY) : gray / 85;
+        if (dithered > 3) dithered = 3;
+        if (config.drawToFramebuffer) drawPixelWithRenderMode(renderer, destX, destY, dithered);
+        if (caching) cache.setPixel(destX, destY, dithered);
+      }
     }
 
     mcuX++;
@@ -258,7 +209,7 @@ bool JpegToFramebufferConverter::decodeToFramebuffer(const std::string& imagePat
 
   // Write cache file if caching was enabled
   if (caching) {
-    cache.writeToFile(config.cachePath);
+    cache.writeToFile(config.cachePath, renderer);
   }
 
   return true;
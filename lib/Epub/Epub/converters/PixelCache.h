@@ -1,14 +1,19 @@
 #pragma once
 
+#include <FramebufferImageCache.h>
+#include <GfxRenderer.h>
 #include <HalStorage.h>
 #include <Logging.h>
+#include <MemoryBudget.h>
 #include <stdint.h>
 
 #include <cstring>
 #include <string>
 
+#include "PixelCacheLayout.h"
+
 // Cache buffer for storing 2-bit pixels (4 levels) during decode.
-// Packs 4 pixels per byte, MSB first.
+// Packs 4 pixels per byte, MSB first. Written out as a FramebufferImageCache, so later renders copy planes.
 struct PixelCache {
   uint8_t* buffer;
   int width;
@@ -16,13 +21,12 @@ struct PixelCache {
   int bytesPerRow;
   int originX;  // config.x - to convert screen coords to cache coords
   int originY;  // config.y
+  size_t reservedBytes;
 
-  PixelCache() : buffer(nullptr), width(0), height(0), bytesPerRow(0), originX(0), originY(0) {}
+  PixelCache() : buffer(nullptr), width(0), height(0), bytesPerRow(0), originX(0), originY(0), reservedBytes(0) {}
   PixelCache(const PixelCache&) = delete;
   PixelCache& operator=(const PixelCache&) = delete;
 
-  static constexpr size_t MAX_CACHE_BYTES = 256 * 1024;  // 256KB limit for embedded targets
-
   bool allocate(int w, int h, int ox, int oy) {
     width = w;
     height = h;
@@ -30,14 +34,17 @@ struct PixelCache {
     originY = oy;
     bytesPerRow = (w + 3) / 4;  // 2 bits per pixel, 4 pixels per byte
     size_t bufferSize = (size_t)bytesPerRow * h;
-    if (bufferSize > MAX_CACHE_BYTES) {
-      LOG_ERR("IMG", "Cache buffer too large: %d bytes for %dx%d (limit %d)", bufferSize, w, h, MAX_CACHE_BYTES);
+    if (!MemBudget.tryReserve(MemoryBudget::Consumer::IMAGE_DECODE, bufferSize)) {
+      LOG_ERR("IMG", "No budget for cache buffer: %d bytes for %dx%d", bufferSize, w, h);
       return false;
     }
     buffer = (uint8_t*)malloc(bufferSize);
     if (buffer) {
+      reservedBytes = bufferSize;
       memset(buffer, 0, bufferSize);
       LOG_DBG("IMG", "Allocated cache buffer: %d bytes for %dx%d", bufferSize, w, h);
+    } else {
+      MemBudget.release(MemoryBudget::Consumer::IMAGE_DECODE, bufferSize);
     }
     return buffer != nullptr;
   }
@@ -53,30 +60,66 @@ struct PixelCache {
     buffer[byteIdx] = (buffer[byteIdx] & ~(0x03 << bitShift)) | ((value & 0x03) << bitShift);
   }
 
-  bool writeToFile(const std::string& cachePath) {
+  // Write the BW, LSB and MSB planes the render passes would draw, pre-rotated to the panel layout. An image that
+  // runs off the screen is cached as the part the panel shows.
+  bool writeToFile(const std::string& cachePath, const GfxRenderer& renderer) {
     if (!buffer) return false;
 
-    FsFile cacheFile;
-    if (!Storage.openFileForWrite("IMG", cachePath, cacheFile)) {
-      LOG_ERR("IMG", "Failed to open cache file for writing: %s", cachePath.c_str());
+    int clipX = originX;
+    int clipY = originY;
+    int clipWidth = width;
+    int clipHeight = height;
+    GfxRenderer::PhysicalRegion region;
+    if (!pixel_cache::clipToScreen(clipX, clipY, clipWidth, clipHeight, renderer.getScreenWidth(),
+                                   renderer.getScreenHeight()) ||
+        !renderer.getPhysicalRegion(clipX, clipY, clipWidth, clipHeight, &region)) {
+      return false;
+    }
+    const size_t planeSize = static_cast<size_t>(region.byteWidth) * region.rows;
+    if (!MemBudget.tryReserve(MemoryBudget::Consumer::IMAGE_DECODE, planeSize)) {
+      LOG_ERR("IMG", "No budget for cache plane: %d bytes", planeSize);
       return false;
     }
+    auto* plane = static_cast<uint8_t*>(malloc(planeSize));
+    FramebufferImageCache cache(renderer, cachePath);
+    bool ok = plane && cache.beginWrite(clipX, clipY, clipWidth, clipHeight, true);
 
-    uint16_t w = width;
-    uint16_t h = height;
-    cacheFile.write(&w, 2);
-    cacheFile.write(&h, 2);
-    cacheFile.write(buffer, bytesPerRow * height);
-    cacheFile.close();
+    for (uint8_t p = FramebufferImageCache::BW_PLANE; ok && p <= FramebufferImageCache::GRAYSCALE_MSB_PLANE; p++) {
+      // Same rules as drawPixelWithRenderMode, on the background each pass clears the screen to
+      const bool bw = p == FramebufferImageCache::BW_PLANE;
+      memset(plane, bw ? 0xFF : 0x00, planeSize);
+      for (int localY = clipY - originY; localY < clipY - originY + clipHeight; localY++) {
+        const uint8_t* row = buffer + localY * bytesPerRow;
+        for (int localX = clipX - originX; localX < clipX - originX + clipWidth; localX++) {
+          const uint8_t value = (row[localX / 4] >> (6 - (localX % 4) * 2)) & 0x03;
+          const bool marked = bw ? value < 3
+                                 : (p == FramebufferImageCache::GRAYSCALE_LSB_PLANE ? value == 1
+                                                                                    : value == 1 || value == 2);
+          if (!marked) continue;
+          int phyX, phyY;
+          renderer.getPhysicalPixel(originX + localX, originY + localY, &phyX, &phyY);
+          uint8_t& byte = plane[(phyY - region.y) * region.byteWidth + phyX / 8 - region.byteX];
+          const uint8_t bit = 0x80 >> (phyX % 8);
+          byte = bw ? byte & ~bit : byte | bit;
+        }
+      }
+      ok = cache.writePlaneData(static_cast<FramebufferImageCache::Plane>(p), plane);
+    }
 
-    LOG_DBG("IMG", "Cache written: %s (%dx%d, %d bytes)", cachePath.c_str(), width, height, 4 + bytesPerRow * height);
-    return true;
+    free(plane);
+    MemBudget.release(MemoryBudget::Consumer::IMAGE_DECODE, planeSize);
+    if (!ok) {
+      LOG_ERR("IMG", "Failed to write cache: %s", cachePath.c_str());
+    }
+    // Removes the file when a plane is missing
+    return cache.finishWrite() && ok;
   }
 
   ~PixelCache() {
     if (buffer) {
       free(buffer);
       buffer = nullptr;
+      MemBudget.release(MemoryBudget::Consumer::IMAGE_DECODE, reservedBytes);
     }
   }
 };
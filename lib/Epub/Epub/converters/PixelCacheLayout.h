@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+// Placement rules for decoded image caches (.pxc). Kept free of device headers so they can be tested on the host.
+namespace pixel_cache {
+
+// The planes of a pixel cache are laid out for one position and orientation, so each placement of an image gets its
+// own file: "<image without extension>.<x>_<y>_<orientation>.pxc". An image shared by several pages, or drawn again
+// after a margin or orientation change, then keeps every placement cached instead of the placements overwriting
+// each other. The name keeps the image's own prefix, so the image manifest prunes it with the image.
+inline std::string pathFor(const std::string& imagePath, const int x, const int y, const int orientation) {
+  const size_t dotPos = imagePath.rfind('.');
+  const size_t slashPos = imagePath.rfind('/');
+  const bool hasExtension = dotPos != std::string::npos && (slashPos == std::string::npos || dotPos > slashPos);
+  char suffix[40];
+  snprintf(suffix, sizeof(suffix), ".%d_%d_%d.pxc", x, y, orientation);
+  return (hasExtension ? imagePath.substr(0, dotPos) : imagePath) + suffix;
+}
+
+// Clip a rect to a screenWidth x screenHeight screen in place. Returns false when no part of it is on screen.
+inline bool clipToScreen(int& x, int& y, int& width, int& height, const int screenWidth, const int screenHeight) {
+  const int left = std::max(x, 0);
+  const int top = std::max(y, 0);
+  const int right = std::min(x + width, screenWidth);
+  const int bottom = std::min(y + height, screenHeight);
+  if (left >= right || top >= bottom) {
+    return false;
+  }
+  x = left;
+  y = top;
+  width = right - left;
+  height = bottom - top;
+  return true;
+}
+
+}  // namespace pixel_cache
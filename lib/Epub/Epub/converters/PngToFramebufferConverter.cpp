@@ -2,12 +2,18 @@
 
 #include <GfxRenderer.h>
 #include <Logging.h>
+#include <MemoryBudget.h>
 #include <PNGdec.h>
 #include <SDCardManager.h>
 #include <SdFat.h>
+#include <uzlib.h>
 
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <new>
+#include <string>
 
 #include "DitherUtils.h"
 #include "PixelCache.h"
@@ -84,11 +90,10 @@ int32_t pngSeekWithHandle(PNGFILE* pFile, int32_t pos) {
 }
 
 // The PNG decoder (PNGdec) is ~42 KB due to internal zlib decompression buffers.
-// We heap-allocate it on demand rather than using a static instance, so this memory
-// is only consumed while actually decoding/querying PNG images. This is critical on
-// the ESP32-C3 where total RAM is ~320 KB.
-constexpr size_t PNG_DECODER_APPROX_SIZE = 44 * 1024;                          // ~42 KB + overhead
-constexpr size_t MIN_FREE_HEAP_FOR_PNG = PNG_DECODER_APPROX_SIZE + 16 * 1024;  // decoder + 16 KB headroom
+// We heap-allocate it on demand rather than using a static instance, and only for files
+// the streaming decoder below doesn't handle. This is critical on the ESP32-C3 where
+// total RAM is ~320 KB.
+constexpr size_t PNG_DECODER_APPROX_SIZE = 44 * 1024;  // ~42 KB + overhead
 
 // PNGdec keeps TWO scanlines in its internal ucPixels buffer (current + previous)
 // and each scanline includes a leading filter byte.
@@ -176,36 +181,34 @@ void convertLineToGray(uint8_t* pPixels, uint8_t* grayLine, int width, int pixel
   }
 }
 
-int pngDrawCallback(PNGDRAW* pDraw) {
-  PngContext* ctx = reinterpret_cast<PngContext*>(pDraw->pUser);
-  if (!ctx || !ctx->config || !ctx->renderer || !ctx->grayLineBuffer) return 0;
-
-  int srcY = pDraw->y;
-  int srcWidth = ctx->srcWidth;
+// Scale one decoded source row into the destination. Shared by the streaming decoder and the PNGdec fallback.
+void drawSourceRow(PngContext& ctx, const int srcY, uint8_t* pixels, const int pixelType, uint8_t* palette,
+                   const int hasAlpha) {
+  int srcWidth = ctx.srcWidth;
 
   // Calculate destination Y with scaling
-  int dstY = (int)(srcY * ctx->scale);
+  int dstY = (int)(srcY * ctx.scale);
 
   // Skip if we already rendered this destination row (multiple source rows map to same dest)
-  if (dstY == ctx->lastDstY) return 1;
-  ctx->lastDstY = dstY;
+  if (dstY == ctx.lastDstY) return;
+  ctx.lastDstY = dstY;
 
   // Check bounds
-  if (dstY >= ctx->dstHeight) return 1;
+  if (dstY >= ctx.dstHeight) return;
 
-  int outY = ctx->config->y + dstY;
-  if (outY >= ctx->screenHeight) return 1;
+  int outY = ctx.config->y + dstY;
+  if (outY >= ctx.screenHeight) return;
 
   // Convert entire source line to grayscale (improves cache locality)
-  convertLineToGray(pDraw->pPixels, ctx->grayLineBuffer, srcWidth, pDraw->iPixelType, pDraw->pPalette,
-                    pDraw->iHasAlpha);
+  convertLineToGray(pixels, ctx.grayLineBuffer, srcWidth, pixelType, palette, hasAlpha);
 
   // Render scaled row using Bresenham-style integer stepping (no floating-point division)
-  int dstWidth = ctx->dstWidth;
-  int outXBase = ctx->config->x;
-  int screenWidth = ctx->screenWidth;
-  bool useDithering = ctx->config->useDithering;
-  bool caching = ctx->caching;
+  int dstWidth = ctx.dstWidth;
+  int outXBase = ctx.config->x;
+  int screenWidth = ctx.screenWidth;
+  bool useDithering = ctx.config->useDithering;
+  bool caching = ctx.caching;
+  bool drawing = ctx.config->drawToFramebuffer;
 
   int srcX = 0;
   int error = 0;
@@ -213,7 +216,7 @@ int pngDrawCallback(PNGDRAW* pDraw) {
   for (int dstX = 0; dstX < dstWidth; dstX++) {
     int outX = outXBase + dstX;
     if (outX < screenWidth) {
-      uint8_t gray = ctx->grayLineBuffer[srcX];
+      uint8_t gray = ctx.grayLineBuffer[srcX];
 
       uint8_t ditheredGray;
       if (useDithering) {
@@ -222,8 +225,8 @@ int pngDrawCallback(PNGDRAW* pDraw) {
         ditheredGray = gray / 85;
         if (ditheredGray > 3) ditheredGray = 3;
       }
-      drawPixelWithRenderMode(*ctx->renderer, outX, outY, ditheredGray);
-      if (caching) ctx->cache.setPixel(outX, outY, ditheredGray);
+      if (drawing) drawPixelWithRenderMode(*ctx.renderer, outX, outY, ditheredGray);
+      if (caching) ctx.cache.setPixel(outX, outY, ditheredGray);
     }
 
     // Bresenham-style stepping: advance srcX based on ratio srcWidth/dstWidth
@@ -233,49 +236,312 @@ int pngDrawCallback(PNGDRAW* pDraw) {
       srcX++;
     }
   }
+}
 
+int pngDrawCallback(PNGDRAW* pDraw) {
+  PngContext* ctx = reinterpret_cast<PngContext*>(pDraw->pUser);
+  if (!ctx || !ctx->config || !ctx->renderer || !ctx->grayLineBuffer) return 0;
+
+  drawSourceRow(*ctx, pDraw->y, pDraw->pPixels, pDraw->iPixelType, pDraw->pPalette, pDraw->iHasAlpha);
   return 1;
 }
 
-}  // namespace
+// ---------------------------------------------------------------------------
+// Streaming decoder: IHDR/PLTE/tRNS are read directly, IDAT is inflated with uzlib one scanline at a time into a
+// dictionary no larger than the image's zlib window. PNG color types share their values with PNGdec's
+// PNG_PIXEL_* constants, so rows go through the same convertLineToGray as the fallback.
+// ---------------------------------------------------------------------------
 
-bool PngToFramebufferConverter::getDimensionsStatic(const std::string& imagePath, ImageDimensions& out) {
-  size_t freeHeap = ESP.getFreeHeap();
-  if (freeHeap < MIN_FREE_HEAP_FOR_PNG) {
-    LOG_ERR("PNG", "Not enough heap for PNG decoder (%u free, need %u)", freeHeap, MIN_FREE_HEAP_FOR_PNG);
+constexpr uint8_t PNG_SIGNATURE[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+
+enum PngFilter : uint8_t {
+  PNG_FILTER_NONE = 0,
+  PNG_FILTER_SUB = 1,
+  PNG_FILTER_UP = 2,
+  PNG_FILTER_AVERAGE = 3,
+  PNG_FILTER_PAETH = 4,
+};
+
+struct PngHeader {
+  uint32_t width;
+  uint32_t height;
+  uint8_t bitDepth;
+  uint8_t colorType;
+  uint8_t interlace;
+};
+
+uint32_t readBE32(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+constexpr uint32_t PNG_IHDR_LENGTH = 13;
+// Dimensions are reported as ImageDimensions (int16_t), and row buffers are sized from the width before any pixel
+// count check, so anything larger is rejected with the header
+constexpr uint32_t PNG_MAX_DIMENSION = INT16_MAX;
+
+// Reads the signature and IHDR, leaving the file at the chunk after IHDR
+bool readPngHeader(FsFile& file, PngHeader& out) {
+  uint8_t buf[8 + 8 + PNG_IHDR_LENGTH + 4];  // Signature, IHDR length and type, IHDR data, CRC
+  if (file.read(buf, sizeof(buf)) != sizeof(buf)) return false;
+  if (memcmp(buf, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0 || readBE32(buf + 8) != PNG_IHDR_LENGTH ||
+      memcmp(buf + 12, "IHDR", 4) != 0) {
     return false;
   }
 
-  PNG* png = new (std::nothrow) PNG();
-  if (!png) {
-    LOG_ERR("PNG", "Failed to allocate PNG decoder for dimensions");
+  out.width = readBE32(buf + 16);
+  out.height = readBE32(buf + 20);
+  out.bitDepth = buf[24];
+  out.colorType = buf[25];
+  out.interlace = buf[28];
+  if (out.width == 0 || out.height == 0 || out.width > PNG_MAX_DIMENSION || out.height > PNG_MAX_DIMENSION) {
+    LOG_ERR("PNG", "Unsupported PNG dimensions %ux%u", static_cast<unsigned>(out.width),
+            static_cast<unsigned>(out.height));
     return false;
   }
+  return buf[26] == 0 && buf[27] == 0;  // Deflate, adaptive filtering
+}
 
-  int rc = png->open(imagePath.c_str(), pngOpenWithHandle, pngCloseWithHandle, pngReadWithHandle, pngSeekWithHandle,
-                     nullptr);
+int channelsForColorType(const uint8_t colorType) {
+  switch (colorType) {
+    case PNG_PIXEL_GRAYSCALE:
+    case PNG_PIXEL_INDEXED:
+      return 1;
+    case PNG_PIXEL_GRAY_ALPHA:
+      return 2;
+    case PNG_PIXEL_TRUECOLOR:
+      return 3;
+    case PNG_PIXEL_TRUECOLOR_ALPHA:
+      return 4;
+    default:
+      return 0;
+  }
+}
 
-  if (rc != 0) {
-    LOG_ERR("PNG", "Failed to open PNG for dimensions: %d", rc);
-    delete png;
-    return false;
+// Non-interlaced images with a bit depth the spec allows for their color type
+bool canStream(const PngHeader& header) {
+  if (header.interlace != 0) return false;
+  switch (header.colorType) {
+    case PNG_PIXEL_GRAYSCALE:
+      return header.bitDepth == 1 || header.bitDepth == 2 || header.bitDepth == 4 || header.bitDepth == 8 ||
+             header.bitDepth == 16;
+    case PNG_PIXEL_INDEXED:
+      return header.bitDepth == 1 || header.bitDepth == 2 || header.bitDepth == 4 || header.bitDepth == 8;
+    case PNG_PIXEL_GRAY_ALPHA:
+    case PNG_PIXEL_TRUECOLOR:
+    case PNG_PIXEL_TRUECOLOR_ALPHA:
+      return header.bitDepth == 8 || header.bitDepth == 16;
+    default:
+      return false;
   }
+}
 
-  out.width = png->getWidth();
-  out.height = png->getHeight();
+// uzlib state first, so the read callback can get from the uzlib_uncomp back to the stream
+struct PngStream {
+  uzlib_uncomp inflater;
+  FsFile* file;
+  uint32_t idatRemaining;  // Bytes left in the current IDAT chunk
+  uint8_t readBuffer[512];
+  uint8_t palette[1024];  // 256 RGB entries then 256 alphas, the layout PNGdec passes to its draw callback
+  bool hasAlpha;
+};
 
-  png->close();
-  delete png;
-  return true;
+// uzlib source callback: refills readBuffer from the IDAT chunks, stepping over chunk boundaries
+int readIdatByte(uzlib_uncomp* inflater) {
+  auto* stream = reinterpret_cast<PngStream*>(inflater);
+  while (stream->idatRemaining == 0) {
+    uint8_t chunkHeader[8];
+    if (!stream->file->seekCur(4) || stream->file->read(chunkHeader, 8) != 8 ||
+        memcmp(chunkHeader + 4, "IDAT", 4) != 0) {
+      return -1;
+    }
+    stream->idatRemaining = readBE32(chunkHeader);
+  }
+
+  const size_t toRead = stream->idatRemaining < sizeof(stream->readBuffer) ? stream->idatRemaining
+                                                                           : sizeof(stream->readBuffer);
+  const int bytesRead = stream->file->read(stream->readBuffer, toRead);
+  if (bytesRead <= 0) return -1;
+  stream->idatRemaining -= bytesRead;
+  inflater->source = stream->readBuffer + 1;
+  inflater->source_limit = stream->readBuffer + bytesRead;
+  return stream->readBuffer[0];
 }
 
-bool PngToFramebufferConverter::decodeToFramebuffer(const std::string& imagePath, GfxRenderer& renderer,
-                                                    const RenderConfig& config) {
-  LOG_DBG("PNG", "Decoding PNG: %s", imagePath.c_str());
+// Walks the chunks up to the first IDAT, picking up PLTE and tRNS on the way
+bool readChunksUntilIdat(PngStream& stream, const PngHeader& header) {
+  memset(stream.palette + 768, 0xFF, 256);
+  while (true) {
+    uint8_t chunkHeader[8];
+    if (stream.file->read(chunkHeader, 8) != 8) return false;
+    const uint32_t length = readBE32(chunkHeader);
+    const uint8_t* type = chunkHeader + 4;
+
+    if (memcmp(type, "IDAT", 4) == 0) {
+      stream.idatRemaining = length;
+      return true;
+    }
+    if (memcmp(type, "IEND", 4) == 0) return false;
+
+    uint32_t consumed = 0;
+    if (memcmp(type, "PLTE", 4) == 0) {
+      consumed = length < 768 ? length : 768;
+      if (stream.file->read(stream.palette, consumed) != static_cast<int>(consumed)) return false;
+    } else if (memcmp(type, "tRNS", 4) == 0 && header.colorType == PNG_PIXEL_INDEXED) {
+      // Color-key transparency on gray/truecolor images is ignored, as it is by the conversion below
+      consumed = length < 256 ? length : 256;
+      if (stream.file->read(stream.palette + 768, consumed) != static_cast<int>(consumed)) return false;
+      stream.hasAlpha = true;
+    }
+    if (!stream.file->seekCur(length - consumed + 4)) return false;  // Rest of the chunk and its CRC
+  }
+}
+
+uint8_t paethPredictor(const uint8_t a, const uint8_t b, const uint8_t c) {
+  const int p = a + b - c;
+  const int pa = p > a ? p - a : a - p;
+  const int pb = p > b ? p - b : b - p;
+  const int pc = p > c ? p - c : c - p;
+  if (pa <= pb && pa <= pc) return a;
+  if (pb <= pc) return b;
+  return c;
+}
+
+bool unfilterRow(const uint8_t filter, uint8_t* row, const uint8_t* prev, const uint32_t length, const int bpp) {
+  switch (filter) {
+    case PNG_FILTER_NONE:
+      return true;
+    case PNG_FILTER_SUB:
+      for (uint32_t i = bpp; i < length; i++) row[i] += row[i - bpp];
+      return true;
+    case PNG_FILTER_UP:
+      for (uint32_t i = 0; i < length; i++) row[i] += prev[i];
+      return true;
+    case PNG_FILTER_AVERAGE:
+      for (uint32_t i = 0; i < length; i++) {
+        const uint8_t left = i >= static_cast<uint32_t>(bpp) ? row[i - bpp] : 0;
+        row[i] += (left + prev[i]) / 2;
+      }
+      return true;
+    case PNG_FILTER_PAETH:
+      for (uint32_t i = 0; i < length; i++) {
+        const bool hasLeft = i >= static_cast<uint32_t>(bpp);
+        row[i] += paethPredictor(hasLeft ? row[i - bpp] : 0, prev[i], hasLeft ? prev[i - bpp] : 0);
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Brings 16-bit samples down to their high byte and unpacks 1/2/4-bit pixels to one byte each,
+// scaling gray levels to 0-255 and leaving palette indices as they are
+void expandRowTo8Bit(const uint8_t* raw, uint8_t* out, const PngHeader& header, const int channels) {
+  if (header.bitDepth == 16) {
+    const uint32_t samples = header.width * channels;
+    for (uint32_t i = 0; i < samples; i++) out[i] = raw[i * 2];
+    return;
+  }
+
+  const int depth = header.bitDepth;
+  const uint8_t mask = (1 << depth) - 1;
+  const uint8_t grayScale = header.colorType == PNG_PIXEL_GRAYSCALE ? 255 / mask : 1;
+  const int pixelsPerByte = 8 / depth;
+  for (uint32_t x = 0; x < header.width; x++) {
+    const int shift = (pixelsPerByte - 1 - static_cast<int>(x % pixelsPerByte)) * depth;
+    out[x] = ((raw[x / pixelsPerByte] >> shift) & mask) * grayScale;
+  }
+}
+
+bool decodeStreaming(FsFile& file, const PngHeader& header, PngContext& ctx) {
+  const int channels = channelsForColorType(header.colorType);
+  const uint32_t bitsPerPixel = channels * header.bitDepth;
+  const uint32_t rowBytes = (header.width * bitsPerPixel + 7) / 8;
+  const int filterBpp = bitsPerPixel >= 8 ? bitsPerPixel / 8 : 1;
+  const size_t expandBytes = header.bitDepth == 8 ? 0 : header.width * channels;
+
+  // Stream state, previous and current row (each with its filter byte), gray line and 8-bit expansion row
+  const size_t workingBytes = sizeof(PngStream) + 2 * (rowBytes + 1) + header.width + expandBytes;
+  const ScopedReservation reservation(MemoryBudget::Consumer::IMAGE_DECODE, workingBytes);
+  if (!reservation) {
+    LOG_ERR("PNG", "Not enough heap for PNG rows (%zu bytes, %u free)", workingBytes, ESP.getFreeHeap());
+    return false;
+  }
+
+  std::unique_ptr<PngStream> stream(new (std::nothrow) PngStream());
+  std::unique_ptr<uint8_t[]> prevRow(new (std::nothrow) uint8_t[rowBytes + 1]());
+  std::unique_ptr<uint8_t[]> curRow(new (std::nothrow) uint8_t[rowBytes + 1]);
+  std::unique_ptr<uint8_t[]> grayLine(new (std::nothrow) uint8_t[header.width]);
+  std::unique_ptr<uint8_t[]> expanded(expandBytes ? new (std::nothrow) uint8_t[expandBytes] : nullptr);
+  if (!stream || !prevRow || !curRow || !grayLine || (expandBytes && !expanded)) {
+    LOG_ERR("PNG", "Failed to allocate PNG row buffers");
+    return false;
+  }
+  stream->file = &file;
 
-  size_t freeHeap = ESP.getFreeHeap();
-  if (freeHeap < MIN_FREE_HEAP_FOR_PNG) {
-    LOG_ERR("PNG", "Not enough heap for PNG decoder (%u free, need %u)", freeHeap, MIN_FREE_HEAP_FOR_PNG);
+  if (!readChunksUntilIdat(*stream, header)) {
+    LOG_ERR("PNG", "No image data found");
+    return false;
+  }
+
+  // zlib header: CM must be deflate, no preset dictionary. CINFO gives the window the encoder used, and a
+  // back-reference can never reach further than the inflated size, so the dictionary is the smaller of the two.
+  stream->inflater.source_read_cb = readIdatByte;
+  const uint8_t cmf = uzlib_get_byte(&stream->inflater);
+  const uint8_t flg = uzlib_get_byte(&stream->inflater);
+  if (stream->inflater.eof || (cmf & 0x0F) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) {
+    LOG_ERR("PNG", "Bad zlib header %02X %02X", cmf, flg);
+    return false;
+  }
+  const uint32_t window = 1u << ((cmf >> 4) + 8);
+  const uint64_t inflatedSize = static_cast<uint64_t>(header.height) * (rowBytes + 1);
+  const uint32_t dictSize = inflatedSize < window ? static_cast<uint32_t>(inflatedSize) : window;
+
+  const ScopedReservation dictReservation(MemoryBudget::Consumer::IMAGE_DECODE, dictSize);
+  std::unique_ptr<uint8_t[]> dict(dictReservation ? new (std::nothrow) uint8_t[dictSize]() : nullptr);
+  if (!dict) {
+    LOG_ERR("PNG", "Not enough heap for %u byte inflate window (%u free)", dictSize, ESP.getFreeHeap());
+    return false;
+  }
+  uzlib_uncompress_init(&stream->inflater, dict.get(), dictSize);
+
+  ctx.grayLineBuffer = grayLine.get();
+  uint8_t* pixels = expandBytes ? expanded.get() : curRow.get() + 1;
+  bool ok = true;
+  for (uint32_t y = 0; y < header.height; y++) {
+    // Rows past the bottom of the destination are never drawn
+    if ((int)(y * ctx.scale) >= ctx.dstHeight) break;
+
+    stream->inflater.dest_start = curRow.get();
+    stream->inflater.dest = curRow.get();
+    stream->inflater.dest_limit = curRow.get() + rowBytes + 1;
+    const int res = uzlib_uncompress(&stream->inflater);
+    if (res < 0 || stream->inflater.dest != stream->inflater.dest_limit) {
+      LOG_ERR("PNG", "Inflate failed at row %u: %d", y, res);
+      ok = false;
+      break;
+    }
+    if (!unfilterRow(curRow[0], curRow.get() + 1, prevRow.get() + 1, rowBytes, filterBpp)) {
+      LOG_ERR("PNG", "Unknown filter type %d at row %u", curRow[0], y);
+      ok = false;
+      break;
+    }
+    if (expandBytes) expandRowTo8Bit(curRow.get() + 1, expanded.get(), header, channels);
+
+    drawSourceRow(ctx, y, pixels, header.colorType, stream->palette, stream->hasAlpha);
+
+    curRow.swap(prevRow);
+    if (!expandBytes) pixels = curRow.get() + 1;
+  }
+  ctx.grayLineBuffer = nullptr;
+  return ok;
+}
+
+// PNGdec path for files the streaming decoder doesn't take. Costs the full ~44 KB decoder instance.
+bool decodeWithPngdec(const std::string& imagePath, PngContext& ctx) {
+  const ScopedReservation reservation(MemoryBudget::Consumer::IMAGE_DECODE, PNG_DECODER_APPROX_SIZE);
+  if (!reservation) {
+    LOG_ERR("PNG", "Not enough heap for PNG decoder (%u free)", ESP.getFreeHeap());
     return false;
   }
 
@@ -286,12 +552,6 @@ bool PngToFramebufferConverter::decodeToFramebuffer(const std::string& imagePath
     return false;
   }
 
-  PngContext ctx;
-  ctx.renderer = &renderer;
-  ctx.config = &config;
-  ctx.screenWidth = renderer.getScreenWidth();
-  ctx.screenHeight = renderer.getScreenHeight();
-
   int rc = png->open(imagePath.c_str(), pngOpenWithHandle, pngCloseWithHandle, pngReadWithHandle, pngSeekWithHandle,
                      pngDrawCallback);
   if (rc != PNG_SUCCESS) {
@@ -300,15 +560,95 @@ bool PngToFramebufferConverter::decodeToFramebuffer(const std::string& imagePath
     return false;
   }
 
-  if (!validateImageDimensions(png->getWidth(), png->getHeight(), "PNG")) {
+  const int pixelType = png->getPixelType();
+  const int requiredInternal = requiredPngInternalBufferBytes(ctx.srcWidth, pixelType);
+  if (requiredInternal > PNG_MAX_BUFFERED_PIXELS) {
+    LOG_ERR("PNG",
+            "PNG row buffer too small: need %d bytes for width=%d type=%d, configured PNG_MAX_BUFFERED_PIXELS=%d",
+            requiredInternal, ctx.srcWidth, pixelType, PNG_MAX_BUFFERED_PIXELS);
+    LOG_ERR("PNG", "Aborting decode to avoid PNGdec internal buffer overflow");
     png->close();
     delete png;
     return false;
   }
 
+  // Allocate grayscale line buffer on demand (~3.2 KB) - freed after decode
+  const size_t grayBufSize = PNG_MAX_BUFFERED_PIXELS / 2;
+  ctx.grayLineBuffer = static_cast<uint8_t*>(malloc(grayBufSize));
+  if (!ctx.grayLineBuffer) {
+    LOG_ERR("PNG", "Failed to allocate gray line buffer");
+    png->close();
+    delete png;
+    return false;
+  }
+
+  rc = png->decode(&ctx, 0);
+
+  free(ctx.grayLineBuffer);
+  ctx.grayLineBuffer = nullptr;
+  png->close();
+  delete png;
+
+  if (rc != PNG_SUCCESS) {
+    LOG_ERR("PNG", "Decode failed: %d", rc);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool PngToFramebufferConverter::getDimensionsStatic(const std::string& imagePath, ImageDimensions& out) {
+  FsFile file;
+  if (!Storage.openFileForRead("PNG", imagePath, file)) {
+    LOG_ERR("PNG", "Failed to open file for dimensions: %s", imagePath.c_str());
+    return false;
+  }
+
+  PngHeader header;
+  const bool ok = readPngHeader(file, header);
+  file.close();
+  if (!ok) {
+    LOG_ERR("PNG", "Invalid PNG header: %s", imagePath.c_str());
+    return false;
+  }
+
+  out.width = header.width;
+  out.height = header.height;
+  return true;
+}
+
+bool PngToFramebufferConverter::decodeToFramebuffer(const std::string& imagePath, GfxRenderer& renderer,
+                                                    const RenderConfig& config) {
+  LOG_DBG("PNG", "Decoding PNG: %s", imagePath.c_str());
+
+  FsFile file;
+  if (!Storage.openFileForRead("PNG", imagePath, file)) {
+    LOG_ERR("PNG", "Failed to open file: %s", imagePath.c_str());
+    return false;
+  }
+
+  PngHeader header;
+  if (!readPngHeader(file, header)) {
+    LOG_ERR("PNG", "Invalid PNG header: %s", imagePath.c_str());
+    file.close();
+    return false;
+  }
+
+  if (!validateImageDimensions(header.width, header.height, "PNG")) {
+    file.close();
+    return false;
+  }
+
+  PngContext ctx;
+  ctx.renderer = &renderer;
+  ctx.config = &config;
+  ctx.screenWidth = renderer.getScreenWidth();
+  ctx.screenHeight = renderer.getScreenHeight();
+
   // Calculate output dimensions
-  ctx.srcWidth = png->getWidth();
-  ctx.srcHeight = png->getHeight();
+  ctx.srcWidth = header.width;
+  ctx.srcHeight = header.height;
 
   if (config.useExactDimensions && config.maxWidth > 0 && config.maxHeight > 0) {
     // Use exact dimensions as specified (avoids rounding mismatches with pre-calculated sizes)
@@ -327,37 +667,8 @@ bool PngToFramebufferConverter::decodeToFramebuffer(const std::string& imagePath
   }
   ctx.lastDstY = -1;  // Reset row tracking
 
-  LOG_DBG("PNG", "PNG %dx%d -> %dx%d (scale %.2f), bpp: %d", ctx.srcWidth, ctx.srcHeight, ctx.dstWidth, ctx.dstHeight,
-          ctx.scale, png->getBpp());
-<<<<<<< HEAD
-
-  const int pixelType = png->getPixelType();
-  const int requiredInternal = requiredPngInternalBufferBytes(ctx.srcWidth, pixelType);
-  if (requiredInternal > PNG_MAX_BUFFERED_PIXELS) {
-    LOG_ERR("PNG",
-            "PNG row buffer too small: need %d bytes for width=%d type=%d, configured PNG_MAX_BUFFERED_PIXELS=%d",
-            requiredInternal, ctx.srcWidth, pixelType, PNG_MAX_BUFFERED_PIXELS);
-    LOG_ERR("PNG", "Aborting decode to avoid PNGdec internal buffer overflow");
-    png->close();
-    delete png;
-    return false;
-  }
-=======
->>>>>>> 0bc6747 (feat: Add PNG cover image support for EPUB books (#827))
-
-  if (png->getBpp() != 8) {
-    warnUnsupportedFeature("bit depth (" + std::to_string(png->getBpp()) + "bpp)", imagePath);
-  }
-
-  // Allocate grayscale line buffer on demand (~3.2 KB) - freed after decode
-  const size_t grayBufSize = PNG_MAX_BUFFERED_PIXELS / 2;
-  ctx.grayLineBuffer = static_cast<uint8_t*>(malloc(grayBufSize));
-  if (!ctx.grayLineBuffer) {
-    LOG_ERR("PNG", "Failed to allocate gray line buffer");
-    png->close();
-    delete png;
-    return false;
-  }
+  LOG_DBG("PNG", "PNG %dx%d -> %dx%d (scale %.2f), depth: %d, color type: %d, interlace: %d", ctx.srcWidth,
+          ctx.srcHeight, ctx.dstWidth, ctx.dstHeight, ctx.scale, header.bitDepth, header.colorType, header.interlace);
 
   // Allocate cache buffer using SCALED dimensions
   ctx.caching = !config.cachePath.empty();
@@ -367,28 +678,37 @@ bool PngToFramebufferConverter::decodeToFramebuffer(const std::string& imagePath
       ctx.caching = false;
     }
   }
+  if (!ctx.caching && !config.drawToFramebuffer) {
+    file.close();
+    return false;
+  }
 
   unsigned long decodeStart = millis();
-  rc = png->decode(&ctx, 0);
+  bool decoded;
+  if (canStream(header)) {
+    decoded = decodeStreaming(file, header, ctx);
+    file.close();
+  } else {
+    file.close();
+    if (header.interlace) {
+      warnUnsupportedFeature("interlacing", imagePath);
+    } else {
+      warnUnsupportedFeature("bit depth " + std::to_string(header.bitDepth) + " with color type " +
+                                 std::to_string(header.colorType),
+                             imagePath);
+    }
+    decoded = decodeWithPngdec(imagePath, ctx);
+  }
   unsigned long decodeTime = millis() - decodeStart;
 
-  free(ctx.grayLineBuffer);
-  ctx.grayLineBuffer = nullptr;
-
-  if (rc != PNG_SUCCESS) {
-    LOG_ERR("PNG", "Decode failed: %d", rc);
-    png->close();
-    delete png;
+  if (!decoded) {
     return false;
   }
-
-  png->close();
-  delete png;
   LOG_DBG("PNG", "PNG decoding complete - render time: %lu ms", decodeTime);
 
   // Write cache file if caching was enabled and buffer was allocated
   if (ctx.caching) {
-    ctx.cache.writeToFile(config.cachePath);
+    ctx.cache.writeToFile(config.cachePath, renderer);
   }
 
   return true;
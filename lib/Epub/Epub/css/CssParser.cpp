@@ -2,10 +2,12 @@
 
 #include <Arduino.h>
 #include <Logging.h>
+#include <MemoryBudget.h>
 
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <new>
 #include <string_view>
 
 namespace {
@@ -41,9 +43,16 @@ constexpr size_t READ_BUFFER_SIZE = 512;
 // Prevents unbounded memory growth from pathological CSS files
 constexpr size_t MAX_RULES = 1500;
 
-// Minimum free heap required to apply CSS during rendering
-// If below this threshold, we skip CSS to avoid display artifacts.
-constexpr size_t MIN_FREE_HEAP_FOR_CSS = 48 * 1024;
+// Cache header: version, rule record size, rule count, chain record size, chain count
+constexpr size_t CACHE_HEADER_SIZE = 1 + 4 * sizeof(uint16_t);
+
+// Selector chains beyond this are dropped, they are kept in RAM and probed for every element
+constexpr size_t MAX_CHAIN_RULES = 256;
+// Bounds on chain matching per element: chains applied, and candidates plus ancestors visited
+constexpr size_t MAX_CHAIN_MATCHES = 8;
+// Rules applied to one element: chains, the tag and two per class. Classes beyond this are ignored.
+constexpr size_t MAX_RESOLVE_MATCHES = 32;
+constexpr int MAX_CHAIN_STEPS = 128;
 
 // Maximum length for a single selector string
 // Prevents parsing of extremely long or malformed selectors
@@ -52,6 +61,46 @@ constexpr size_t MAX_SELECTOR_LENGTH = 256;
 // Check if character is CSS whitespace
 bool isCssWhitespace(const char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f'; }
 
+// FNV-1a, fed incrementally so `tag`, `.class` and `tag.class` keys are hashed without building strings
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+uint64_t hashChar(const uint64_t hash, const char c) { return (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME; }
+
+uint64_t hashLowercase(uint64_t hash, const std::string_view s) {
+  for (const char c : s) {
+    hash = hashChar(hash, static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+  }
+  return hash;
+}
+
+// 32-bit keys used by selector chains, `.`-prefixed for classes so a class never matches a tag of the same name
+uint32_t foldHash(const uint64_t hash) {
+  const auto folded = static_cast<uint32_t>(hash ^ (hash >> 32));
+  return folded != 0 ? folded : 1;  // 0 means "any tag" in a compound
+}
+
+uint32_t tagKeyHash(const std::string_view tag) { return foldHash(hashLowercase(FNV_OFFSET_BASIS, tag)); }
+
+uint32_t classKeyHash(const std::string_view cls) {
+  return foldHash(hashLowercase(hashChar(FNV_OFFSET_BASIS, '.'), cls));
+}
+
+// Call fn for each whitespace-separated token of s
+template <typename Fn>
+void forEachToken(const std::string_view s, Fn&& fn) {
+  size_t start = 0;
+  while (start < s.size()) {
+    while (start < s.size() && isCssWhitespace(s[start])) ++start;
+    size_t end = start;
+    while (end < s.size() && !isCssWhitespace(s[end])) ++end;
+    if (end > start) {
+      fn(s.substr(start, end - start));
+    }
+    start = end;
+  }
+}
+
 }  // anonymous namespace
 
 // String utilities implementation
@@ -346,7 +395,7 @@ CssStyle CssParser::parseDeclarations(const std::string& declBlock) {
 
 void CssParser::processRuleBlockWithStyle(const std::string& selectorGroup, const CssStyle& style) {
   // Check if we've reached the rule limit before processing
-  if (rulesBySelector_.size() >= MAX_RULES) {
+  if (rules.size() >= MAX_RULES) {
     LOG_DBG("CSS", "Reached max rules limit (%zu), stopping CSS parsing", MAX_RULES);
     return;
   }
@@ -371,12 +420,6 @@ void CssParser::processRuleBlockWithStyle(const std::string& selectorGroup, cons
       continue;
     }
 
-    // TODO: Consider adding support for direct nested css selectors in the future
-    // Ensure no > in selector as we don't support nested CSS selectors for now
-    if (key.find('>') != std::string_view::npos) {
-      continue;
-    }
-
     // TODO: Consider adding support for attribute css selectors in the future
     // Ensure no [ in selector as we don't support attribute CSS selectors for now
     if (key.find('[') != std::string_view::npos) {
@@ -407,27 +450,138 @@ void CssParser::processRuleBlockWithStyle(const std::string& selectorGroup, cons
       continue;
     }
 
-    // TODO: Add support for more complex selectors in the future
-    // At the moment, we only ever check for `tag`, `tag.class1` or `.class1`
-    // If the selector has whitespace in it, then it's either a CSS selector for a descendant element (e.g. `tag1 tag2`)
-    // or some other slightly more advanced CSS selector which we don't support yet
-    if (key.find(' ') != std::string_view::npos) {
-      continue;
-    }
-
     // Skip if this would exceed the rule limit
-    if (rulesBySelector_.size() >= MAX_RULES) {
+    if (rules.size() >= MAX_RULES) {
       LOG_DBG("CSS", "Reached max rules limit, stopping selector processing");
       return;
     }
 
-    // Store or merge with existing
-    auto it = rulesBySelector_.find(key);
-    if (it != rulesBySelector_.end()) {
-      it->second.applyOver(style);
-    } else {
-      rulesBySelector_[key] = style;
+    // `tag`, `.class` and `tag.class` are looked up directly, anything else is compiled into a selector chain
+    const uint64_t selectorHash = hashLowercase(FNV_OFFSET_BASIS, key);
+    const size_t firstDot = key.find('.');
+    const bool simple = key.find_first_of(" >") == std::string::npos &&
+                        (firstDot == std::string::npos || key.find('.', firstDot + 1) == std::string::npos);
+    if (!simple && !addChainRule(key, selectorHash)) {
+      continue;
+    }
+    addRule(selectorHash, style, nextSourceOrder);
+    if (nextSourceOrder < UINT16_MAX) {
+      nextSourceOrder++;
+    }
+  }
+}
+
+bool CssParser::compileCompound(const std::string_view text, Compound& out, uint16_t& specificity) {
+  out = Compound{};
+  const size_t dot = text.find('.');
+  const std::string_view tag = text.substr(0, dot);
+  if (!tag.empty()) {
+    out.tagHash = tagKeyHash(tag);
+    specificity += 1;
+  }
+  if (dot == std::string_view::npos) {
+    return !tag.empty();
+  }
+
+  size_t start = dot + 1;
+  while (true) {
+    const size_t end = text.find('.', start);
+    const std::string_view cls = text.substr(start, end == std::string_view::npos ? end : end - start);
+    if (cls.empty() || out.classCount == MAX_COMPOUND_CLASSES) {
+      return false;
+    }
+    out.classHashes[out.classCount++] = classKeyHash(cls);
+    specificity += 256;
+    if (end == std::string_view::npos) {
+      return true;
+    }
+    start = end + 1;
+  }
+}
+
+bool CssParser::addChainRule(const std::string& key, const uint64_t selectorHash) {
+  for (const auto& existing : chainRules) {
+    if (existing.selectorHash == selectorHash) {
+      return true;
+    }
+  }
+  if (chainRules.size() >= MAX_CHAIN_RULES) {
+    LOG_DBG("CSS", "Reached max selector chains (%zu), skipping: %s", MAX_CHAIN_RULES, key.c_str());
+    return false;
+  }
+
+  // Split into compounds left to right, remembering the combinator before each one
+  std::array<std::string_view, MAX_CHAIN_COMPOUNDS> texts;
+  std::array<uint8_t, MAX_CHAIN_COMPOUNDS> combinators = {};
+  size_t count = 0;
+  uint8_t pending = COMBINATOR_NONE;
+  const std::string_view selector(key);
+  size_t i = 0;
+  while (i < selector.size()) {
+    if (selector[i] == ' ') {
+      if (count > 0 && pending == COMBINATOR_NONE) {
+        pending = COMBINATOR_DESCENDANT;
+      }
+      i++;
+      continue;
+    }
+    if (selector[i] == '>') {
+      if (count == 0) {
+        return false;
+      }
+      pending = COMBINATOR_CHILD;
+      i++;
+      continue;
+    }
+    if (count == MAX_CHAIN_COMPOUNDS) {
+      LOG_DBG("CSS", "Selector chain too long, skipping: %s", key.c_str());
+      return false;
     }
+    size_t end = selector.find_first_of(" >", i);
+    if (end == std::string_view::npos) {
+      end = selector.size();
+    }
+    texts[count] = selector.substr(i, end - i);
+    combinators[count] = pending;
+    count++;
+    pending = COMBINATOR_NONE;
+    i = end;
+  }
+  if (count == 0 || pending != COMBINATOR_NONE) {
+    return false;
+  }
+
+  // Compile right to left so matching starts at the subject
+  ChainRule rule = {};
+  rule.selectorHash = selectorHash;
+  rule.compoundCount = static_cast<uint8_t>(count);
+  for (size_t k = 0; k < count; k++) {
+    const size_t source = count - 1 - k;
+    if (!compileCompound(texts[source], rule.compounds[k], rule.specificity)) {
+      return false;
+    }
+    rule.compounds[k].combinator = combinators[source];
+  }
+  const Compound& subject = rule.compounds[0];
+  rule.subjectKey = subject.classCount > 0 ? subject.classHashes[0] : subject.tagHash;
+
+  // Keep sorted by subject key, in source order among equal keys
+  const auto it =
+      std::upper_bound(chainRules.begin(), chainRules.end(), rule.subjectKey,
+                       [](const uint32_t subjectKey, const ChainRule& other) { return subjectKey < other.subjectKey; });
+  chainRules.insert(it, rule);
+  return true;
+}
+
+void CssParser::addRule(const uint64_t selectorHash, const CssStyle& style, const uint16_t sourceOrder) {
+  // Store or merge with existing, keeping the table sorted. A redefinition moves the rule to its later position.
+  const auto it = std::lower_bound(rules.begin(), rules.end(), selectorHash,
+                                   [](const Rule& rule, const uint64_t hash) { return rule.selectorHash < hash; });
+  if (it != rules.end() && it->selectorHash == selectorHash) {
+    it->style.applyOver(style);
+    it->sourceOrder = sourceOrder;
+  } else {
+    rules.insert(it, Rule{selectorHash, style, sourceOrder});
   }
 }
 
@@ -575,60 +729,256 @@ bool CssParser::loadFromStream(FsFile& source) {
     handleChar('/');
   }
 
-  LOG_DBG("CSS", "Parsed %zu rules from %zu bytes", rulesBySelector_.size(), totalRead);
+  LOG_DBG("CSS", "Parsed %zu rules from %zu bytes", rules.size(), totalRead);
   return true;
 }
 
 // Style resolution
 
-CssStyle CssParser::resolveStyle(const std::string& tagName, const std::string& classAttr) const {
-  static bool lowHeapWarningLogged = false;
-  if (ESP.getFreeHeap() < MIN_FREE_HEAP_FOR_CSS) {
-    if (!lowHeapWarningLogged) {
-      lowHeapWarningLogged = true;
-      LOG_DBG("CSS", "Warning: low heap (%u bytes) below MIN_FREE_HEAP_FOR_CSS (%u), returning empty style",
-              ESP.getFreeHeap(), static_cast<unsigned>(MIN_FREE_HEAP_FOR_CSS));
+const CssParser::Rule* CssParser::lookupRule(const uint64_t selectorHash, Rule& scratch) const {
+  if (!tableFile) {
+    const auto it = std::lower_bound(rules.begin(), rules.end(), selectorHash,
+                                     [](const Rule& rule, const uint64_t hash) { return rule.selectorHash < hash; });
+    if (it == rules.end() || it->selectorHash != selectorHash) {
+      return nullptr;
     }
-    return CssStyle{};
+    return &*it;
   }
-  CssStyle result;
-  const std::string tag = normalized(tagName);
 
-  // 1. Apply element-level style (lowest priority)
-  const auto tagIt = rulesBySelector_.find(tag);
-  if (tagIt != rulesBySelector_.end()) {
-    result.applyOver(tagIt->second);
+  // Table stayed on the card, binary search its records
+  size_t lo = 0;
+  size_t hi = fileRuleCount;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (!tableFile.seekSet(CACHE_HEADER_SIZE + mid * sizeof(Rule)) ||
+        tableFile.read(&scratch, sizeof(Rule)) != static_cast<int>(sizeof(Rule))) {
+      LOG_ERR("CSS", "Failed to read rule %zu from cache", mid);
+      return nullptr;
+    }
+    if (scratch.selectorHash == selectorHash) {
+      return &scratch;
+    }
+    if (scratch.selectorHash < selectorHash) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return nullptr;
+}
+
+bool CssParser::findRule(const uint64_t selectorHash, CssStyle& out) const {
+  Rule scratch;
+  const Rule* rule = lookupRule(selectorHash, scratch);
+  if (!rule) {
+    return false;
+  }
+  out.applyOver(rule->style);
+  return true;
+}
+
+bool CssParser::compoundMatches(const Compound& compound, const CssElementKey& element) {
+  if (compound.tagHash != 0 && compound.tagHash != element.tagHash) {
+    return false;
   }
+  for (uint8_t i = 0; i < compound.classCount; i++) {
+    const uint32_t* end = element.classHashes + element.classCount;
+    if (std::find(element.classHashes, end, compound.classHashes[i]) == end) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  // TODO: Support combinations of classes (e.g. style on .class1.class2)
-  // 2. Apply class styles (medium priority)
-  if (!classAttr.empty()) {
-    const auto classes = splitWhitespace(classAttr);
+bool CssParser::ancestorsMatch(const ChainRule& rule, const size_t index, const CssElementKey* path,
+                               const size_t position, int& budget) {
+  if (index + 1 == rule.compoundCount) {
+    return true;
+  }
+  const Compound& next = rule.compounds[index + 1];
 
-    for (const auto& cls : classes) {
-      std::string classKey = "." + normalized(cls);
+  if (rule.compounds[index].combinator == COMBINATOR_CHILD) {
+    return position > 0 && --budget >= 0 && compoundMatches(next, path[position - 1]) &&
+           ancestorsMatch(rule, index + 1, path, position - 1, budget);
+  }
 
-      auto classIt = rulesBySelector_.find(classKey);
-      if (classIt != rulesBySelector_.end()) {
-        result.applyOver(classIt->second);
+  // Descendant: try each ancestor, backtracking when the rest of the chain fails
+  for (size_t p = position; p-- > 0;) {
+    if (--budget < 0) {
+      return false;
+    }
+    if (compoundMatches(next, path[p]) && ancestorsMatch(rule, index + 1, path, p, budget)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t CssParser::matchChains(const CssElementKey* path, const size_t pathLength, RuleMatch* matches) const {
+  const unsigned long start = micros();
+  const CssElementKey& element = path[pathLength - 1];
+  int budget = MAX_CHAIN_STEPS;
+  size_t count = 0;
+
+  const auto probe = [&](const uint32_t subjectKey) {
+    auto it = std::lower_bound(
+        chainRules.begin(), chainRules.end(), subjectKey,
+        [](const ChainRule& rule, const uint32_t key) { return rule.subjectKey < key; });
+    for (; it != chainRules.end() && it->subjectKey == subjectKey; ++it) {
+      if (count == MAX_CHAIN_MATCHES || --budget < 0) {
+        return;
+      }
+      if (!compoundMatches(it->compounds[0], element) || !ancestorsMatch(*it, 0, path, pathLength - 1, budget)) {
+        continue;
       }
+      // Ordered together with the element's single selectors in resolveUncached
+      matches[count++] = RuleMatch{it->specificity, 0, it->selectorHash};
     }
+  };
 
-    // TODO: Support combinations of classes (e.g. style on p.class1.class2)
-    // 3. Apply element.class styles (higher priority)
-    for (const auto& cls : classes) {
-      std::string combinedKey = tag + "." + normalized(cls);
+  probe(element.tagHash);
+  for (uint8_t i = 0; i < element.classCount; i++) {
+    probe(element.classHashes[i]);
+  }
 
-      auto combinedIt = rulesBySelector_.find(combinedKey);
-      if (combinedIt != rulesBySelector_.end()) {
-        result.applyOver(combinedIt->second);
-      }
+  chainElements++;
+  chainMatches += count;
+  if (budget < 0) {
+    chainBudgetHits++;
+  }
+  chainMicros += micros() - start;
+  return count;
+}
+
+CssStyle CssParser::resolveUncached(const uint64_t tagHash, const std::string_view classAttr, const RuleMatch* chains,
+                                    const size_t chainCount) const {
+  // Collect every rule that applies in cascade order: by specificity, and by source order among equals, so a later
+  // `p.note` still beats an earlier `div .note`
+  RuleMatch matches[MAX_RESOLVE_MATCHES];
+  size_t count = 0;
+  Rule scratch;
+  const auto add = [&](const uint64_t selectorHash, const uint16_t specificity) {
+    if (count == MAX_RESOLVE_MATCHES) {
+      return;
     }
+    const Rule* rule = lookupRule(selectorHash, scratch);
+    if (!rule) {
+      return;
+    }
+    const auto after = [&](const RuleMatch& other) {
+      return other.specificity > specificity ||
+             (other.specificity == specificity && other.sourceOrder > rule->sourceOrder);
+    };
+    size_t pos = count++;
+    for (; pos > 0 && after(matches[pos - 1]); pos--) {
+      matches[pos] = matches[pos - 1];
+    }
+    matches[pos] = RuleMatch{specificity, rule->sourceOrder, selectorHash};
+  };
+
+  for (size_t i = 0; i < chainCount; i++) {
+    add(chains[i].selectorHash, chains[i].specificity);
   }
+  // `tag` counts one tag, `.class` one class and `tag.class` both, as chain specificities do
+  add(tagHash, 1);
+  const uint64_t classBase = hashChar(FNV_OFFSET_BASIS, '.');
+  const uint64_t combinedBase = hashChar(tagHash, '.');
+  forEachToken(classAttr, [&](const std::string_view cls) {
+    add(hashLowercase(classBase, cls), 256);
+    add(hashLowercase(combinedBase, cls), 257);
+  });
 
+  CssStyle result;
+  for (size_t i = 0; i < count; i++) {
+    findRule(matches[i].selectorHash, result);
+  }
   return result;
 }
 
+CssElementKey CssParser::makeElementKey(const std::string_view tagName, const std::string_view classAttr) {
+  CssElementKey key;
+  key.tagHash = tagKeyHash(tagName);
+  forEachToken(classAttr, [&key](const std::string_view cls) {
+    if (key.classCount < CssElementKey::MAX_CLASSES) {
+      key.classHashes[key.classCount++] = classKeyHash(cls);
+    }
+  });
+  return key;
+}
+
+CssStyle CssParser::resolveStyle(const std::string_view tagName, const std::string_view classAttr,
+                                 const CssElementKey* path, const size_t pathLength) const {
+  if (empty()) {
+    return CssStyle{};
+  }
+
+  const uint64_t tagHash = hashLowercase(FNV_OFFSET_BASIS, tagName);
+
+  // Chain results depend on the ancestors, so only elements no chain matched use the memo
+  if (path && pathLength > 0 && !chainRules.empty()) {
+    RuleMatch matches[MAX_CHAIN_MATCHES];
+    const size_t matchCount = matchChains(path, pathLength, matches);
+    if (matchCount > 0) {
+      return resolveUncached(tagHash, classAttr, matches, matchCount);
+    }
+  }
+
+  // Class names match case-insensitively, so differently cased attributes share a memo entry
+  const uint64_t key = hashLowercase(hashChar(tagHash, '\0'), classAttr);
+
+  if (!memo) {
+    memo.reset(new (std::nothrow) MemoEntry[MEMO_SIZE]());
+  }
+  if (!memo) {
+    return resolveUncached(tagHash, classAttr);
+  }
+
+  MemoEntry& entry = memo[key % MEMO_SIZE];
+  if (entry.valid && entry.key == key) {
+    memoHits++;
+    return entry.style;
+  }
+  memoMisses++;
+  entry.style = resolveUncached(tagHash, classAttr);
+  entry.key = key;
+  entry.valid = true;
+  return entry.style;
+}
+
+void CssParser::clear() {
+  if (memoHits + memoMisses > 0) {
+    LOG_DBG("CSS", "Style memo: %u hits, %u misses", memoHits, memoMisses);
+  }
+  if (chainElements > 0) {
+    LOG_DBG("CSS", "Selector chains: %u elements, %u matches, %u over budget, %lu us", chainElements, chainMatches,
+            chainBudgetHits, chainMicros);
+  }
+  memo.reset();
+  memoHits = 0;
+  memoMisses = 0;
+  chainElements = 0;
+  chainMatches = 0;
+  chainBudgetHits = 0;
+  chainMicros = 0;
+  // Release the tables' memory, not just their contents
+  std::vector<Rule>().swap(rules);
+  std::vector<ChainRule>().swap(chainRules);
+  // Unregistered on its own: pressure may have released the rule table, leaving nothing reserved
+  if (pressureCallbackSet) {
+    MemBudget.setPressureCallback(MemoryBudget::Consumer::CSS, nullptr, nullptr);
+    pressureCallbackSet = false;
+  }
+  if (reservedBytes > 0) {
+    MemBudget.release(MemoryBudget::Consumer::CSS, reservedBytes);
+    reservedBytes = 0;
+  }
+  if (tableFile) {
+    tableFile.close();
+  }
+  fileRuleCount = 0;
+  nextSourceOrder = 0;
+}
+
 // Inline style parsing (static - doesn't need rule database)
 
 CssStyle CssParser::parseInlineStyle(const std::string& styleValue) { return parseDeclarations(styleValue); }
@@ -654,66 +1004,30 @@ bool CssParser::saveToCache() const {
     return false;
   }
 
-  // Write version
+  // Header: version, then record size (guards against layout changes) and count of each table
+  const auto ruleRecordSize = static_cast<uint16_t>(sizeof(Rule));
+  const auto ruleCount = static_cast<uint16_t>(rules.size());
+  const auto chainRecordSize = static_cast<uint16_t>(sizeof(ChainRule));
+  const auto chainCount = static_cast<uint16_t>(chainRules.size());
   file.write(CssParser::CSS_CACHE_VERSION);
-
-  // Write rule count
-  const auto ruleCount = static_cast<uint16_t>(rulesBySelector_.size());
+  file.write(reinterpret_cast<const uint8_t*>(&ruleRecordSize), sizeof(ruleRecordSize));
   file.write(reinterpret_cast<const uint8_t*>(&ruleCount), sizeof(ruleCount));
+  file.write(reinterpret_cast<const uint8_t*>(&chainRecordSize), sizeof(chainRecordSize));
+  file.write(reinterpret_cast<const uint8_t*>(&chainCount), sizeof(chainCount));
+
+  // Both tables are kept sorted, so they are written as-is
+  const size_t tableBytes = rules.size() * sizeof(Rule);
+  const size_t chainBytes = chainRules.size() * sizeof(ChainRule);
+  if ((tableBytes > 0 && file.write(reinterpret_cast<const uint8_t*>(rules.data()), tableBytes) != tableBytes) ||
+      (chainBytes > 0 &&
+       file.write(reinterpret_cast<const uint8_t*>(chainRules.data()), chainBytes) != chainBytes)) {
+    LOG_ERR("CSS", "Failed to write rule tables");
+    file.close();
+    Storage.remove((cachePath + rulesCache).c_str());
+    return false;
+  }
 
-  // Write each rule: selector string + CssStyle fields
-  for (const auto& pair : rulesBySelector_) {
-    // Write selector string (length-prefixed)
-    const auto selectorLen = static_cast<uint16_t>(pair.first.size());
-    file.write(reinterpret_cast<const uint8_t*>(&selectorLen), sizeof(selectorLen));
-    file.write(reinterpret_cast<const uint8_t*>(pair.first.data()), selectorLen);
-
-    // Write CssStyle fields (all are POD types)
-    const CssStyle& style = pair.second;
-    file.write(static_cast<uint8_t>(style.textAlign));
-    file.write(static_cast<uint8_t>(style.fontStyle));
-    file.write(static_cast<uint8_t>(style.fontWeight));
-    file.write(static_cast<uint8_t>(style.textDecoration));
-
-    // Write CssLength fields (value + unit)
-    auto writeLength = [&file](const CssLength& len) {
-      file.write(reinterpret_cast<const uint8_t*>(&len.value), sizeof(len.value));
-      file.write(static_cast<uint8_t>(len.unit));
-    };
-
-    writeLength(style.textIndent);
-    writeLength(style.marginTop);
-    writeLength(style.marginBottom);
-    writeLength(style.marginLeft);
-    writeLength(style.marginRight);
-    writeLength(style.paddingTop);
-    writeLength(style.paddingBottom);
-    writeLength(style.paddingLeft);
-    writeLength(style.paddingRight);
-    writeLength(style.imageHeight);
-    writeLength(style.imageWidth);
-
-    // Write defined flags as uint16_t
-    uint16_t definedBits = 0;
-    if (style.defined.textAlign) definedBits |= 1 << 0;
-    if (style.defined.fontStyle) definedBits |= 1 << 1;
-    if (style.defined.fontWeight) definedBits |= 1 << 2;
-    if (style.defined.textDecoration) definedBits |= 1 << 3;
-    if (style.defined.textIndent) definedBits |= 1 << 4;
-    if (style.defined.marginTop) definedBits |= 1 << 5;
-    if (style.defined.marginBottom) definedBits |= 1 << 6;
-    if (style.defined.marginLeft) definedBits |= 1 << 7;
-    if (style.defined.marginRight) definedBits |= 1 << 8;
-    if (style.defined.paddingTop) definedBits |= 1 << 9;
-    if (style.defined.paddingBottom) definedBits |= 1 << 10;
-    if (style.defined.paddingLeft) definedBits |= 1 << 11;
-    if (style.defined.paddingRight) definedBits |= 1 << 12;
-    if (style.defined.imageHeight) definedBits |= 1 << 13;
-    if (style.defined.imageWidth) definedBits |= 1 << 14;
-    file.write(reinterpret_cast<const uint8_t*>(&definedBits), sizeof(definedBits));
-  }
-
-  LOG_DBG("CSS", "Saved %u rules to cache", ruleCount);
+  LOG_DBG("CSS", "Saved %u rules and %u selector chains to cache", ruleCount, chainCount);
   file.close();
   return true;
 }
@@ -723,130 +1037,98 @@ bool CssParser::loadFromCache() {
     return false;
   }
 
-  FsFile file;
-  if (!Storage.openFileForRead("CSS", cachePath + rulesCache, file)) {
-    return false;
-  }
-
   // Clear existing rules
   clear();
 
-  // Read and verify version
-  uint8_t version = 0;
-  if (file.read(&version, 1) != 1 || version != CssParser::CSS_CACHE_VERSION) {
-    LOG_DBG("CSS", "Cache version mismatch (got %u, expected %u), removing stale cache for rebuild", version,
-            CssParser::CSS_CACHE_VERSION);
-    file.close();
-    Storage.remove((cachePath + rulesCache).c_str());
+  FsFile file;
+  if (!Storage.openFileForRead("CSS", cachePath + rulesCache, file)) {
     return false;
   }
 
-  // Read rule count
+  // Read and verify version and record layout
+  uint8_t version = 0;
+  uint16_t ruleRecordSize = 0;
   uint16_t ruleCount = 0;
-  if (file.read(&ruleCount, sizeof(ruleCount)) != sizeof(ruleCount)) {
+  uint16_t chainRecordSize = 0;
+  uint16_t chainCount = 0;
+  if (file.read(&version, 1) != 1 || version != CssParser::CSS_CACHE_VERSION ||
+      file.read(&ruleRecordSize, sizeof(ruleRecordSize)) != sizeof(ruleRecordSize) ||
+      file.read(&ruleCount, sizeof(ruleCount)) != sizeof(ruleCount) ||
+      file.read(&chainRecordSize, sizeof(chainRecordSize)) != sizeof(chainRecordSize) ||
+      file.read(&chainCount, sizeof(chainCount)) != sizeof(chainCount) || ruleRecordSize != sizeof(Rule) ||
+      chainRecordSize != sizeof(ChainRule) ||
+      file.size() != CACHE_HEADER_SIZE + static_cast<size_t>(ruleCount) * sizeof(Rule) +
+                         static_cast<size_t>(chainCount) * sizeof(ChainRule)) {
+    LOG_DBG("CSS", "Cache version mismatch or corrupt (got v%u, expected v%u), removing stale cache for rebuild",
+            version, CssParser::CSS_CACHE_VERSION);
     file.close();
+    Storage.remove((cachePath + rulesCache).c_str());
     return false;
   }
 
-  // Read each rule
-  for (uint16_t i = 0; i < ruleCount; ++i) {
-    // Read selector string
-    uint16_t selectorLen = 0;
-    if (file.read(&selectorLen, sizeof(selectorLen)) != sizeof(selectorLen)) {
-      rulesBySelector_.clear();
+  // Chains are always matched from RAM, they are small next to the rule table
+  const size_t tableBytes = static_cast<size_t>(ruleCount) * sizeof(Rule);
+  const size_t chainBytes = static_cast<size_t>(chainCount) * sizeof(ChainRule);
+  if (chainBytes > 0 && !MemBudget.tryReserve(MemoryBudget::Consumer::CSS, chainBytes)) {
+    LOG_ERR("CSS", "Low heap, ignoring %u selector chains", chainCount);
+  } else if (chainBytes > 0) {
+    reservedBytes += chainBytes;
+    chainRules.resize(chainCount);
+    if (!file.seekSet(CACHE_HEADER_SIZE + tableBytes) ||
+        file.read(chainRules.data(), chainBytes) != static_cast<int>(chainBytes) || !file.seekSet(CACHE_HEADER_SIZE)) {
+      LOG_ERR("CSS", "Failed to read selector chains");
+      clear();
       file.close();
       return false;
     }
+  }
 
-    std::string selector;
-    selector.resize(selectorLen);
-    if (file.read(&selector[0], selectorLen) != selectorLen) {
-      rulesBySelector_.clear();
-      file.close();
-      return false;
-    }
-
-    // Read CssStyle fields
-    CssStyle style;
-    uint8_t enumVal;
-
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      file.close();
-      return false;
-    }
-    style.textAlign = static_cast<CssTextAlign>(enumVal);
-
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      file.close();
-      return false;
-    }
-    style.fontStyle = static_cast<CssFontStyle>(enumVal);
-
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      file.close();
-      return false;
-    }
-    style.fontWeight = static_cast<CssFontWeight>(enumVal);
-
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      file.close();
+  // Keep the table on the card when loading it would leave too little heap for page building
+  if (tableBytes > 0 && !MemBudget.tryReserve(MemoryBudget::Consumer::CSS, tableBytes)) {
+    LOG_DBG("CSS", "Low heap, serving %u rules from cache file", ruleCount);
+    file.close();
+    if (!Storage.openFileForRead("CSS", cachePath + rulesCache, tableFile)) {
+      clear();
       return false;
     }
-    style.textDecoration = static_cast<CssTextDecoration>(enumVal);
-
-    // Read CssLength fields
-    auto readLength = [&file](CssLength& len) -> bool {
-      if (file.read(&len.value, sizeof(len.value)) != sizeof(len.value)) {
-        return false;
-      }
-      uint8_t unitVal;
-      if (file.read(&unitVal, 1) != 1) {
-        return false;
-      }
-      len.unit = static_cast<CssUnit>(unitVal);
-      return true;
-    };
+    fileRuleCount = ruleCount;
+    return true;
+  }
 
-    if (!readLength(style.textIndent) || !readLength(style.marginTop) || !readLength(style.marginBottom) ||
-        !readLength(style.marginLeft) || !readLength(style.marginRight) || !readLength(style.paddingTop) ||
-        !readLength(style.paddingBottom) || !readLength(style.paddingLeft) || !readLength(style.paddingRight) ||
-        !readLength(style.imageHeight) || !readLength(style.imageWidth)) {
-      rulesBySelector_.clear();
-      file.close();
-      return false;
-    }
+  reservedBytes += tableBytes;
+  rules.resize(ruleCount);
+  if (tableBytes > 0 && file.read(rules.data(), tableBytes) != static_cast<int>(tableBytes)) {
+    LOG_ERR("CSS", "Failed to read rule table");
+    clear();
+    file.close();
+    return false;
+  }
+  // More important consumers may push the table back to the card. The budget only calls back on this task, the one
+  // that builds the section and reads the table, so the swap never races a lookup.
+  MemBudget.setPressureCallback(MemoryBudget::Consumer::CSS, &CssParser::onMemoryPressure, this);
+  pressureCallbackSet = true;
 
-    // Read defined flags
-    uint16_t definedBits = 0;
-    if (file.read(&definedBits, sizeof(definedBits)) != sizeof(definedBits)) {
-      rulesBySelector_.clear();
-      file.close();
-      return false;
-    }
-    style.defined.textAlign = (definedBits & 1 << 0) != 0;
-    style.defined.fontStyle = (definedBits & 1 << 1) != 0;
-    style.defined.fontWeight = (definedBits & 1 << 2) != 0;
-    style.defined.textDecoration = (definedBits & 1 << 3) != 0;
-    style.defined.textIndent = (definedBits & 1 << 4) != 0;
-    style.defined.marginTop = (definedBits & 1 << 5) != 0;
-    style.defined.marginBottom = (definedBits & 1 << 6) != 0;
-    style.defined.marginLeft = (definedBits & 1 << 7) != 0;
-    style.defined.marginRight = (definedBits & 1 << 8) != 0;
-    style.defined.paddingTop = (definedBits & 1 << 9) != 0;
-    style.defined.paddingBottom = (definedBits & 1 << 10) != 0;
-    style.defined.paddingLeft = (definedBits & 1 << 11) != 0;
-    style.defined.paddingRight = (definedBits & 1 << 12) != 0;
-    style.defined.imageHeight = (definedBits & 1 << 13) != 0;
-    style.defined.imageWidth = (definedBits & 1 << 14) != 0;
-
-    rulesBySelector_[selector] = style;
-  }
-
-  LOG_DBG("CSS", "Loaded %u rules from cache", ruleCount);
+  LOG_DBG("CSS", "Loaded %u rules and %u selector chains from cache", ruleCount, chainCount);
   file.close();
   return true;
 }
+
+void CssParser::onMemoryPressure(void* context, size_t /*bytesWanted*/) {
+  auto* self = static_cast<CssParser*>(context);
+  if (self->rules.empty() || self->tableFile) {
+    return;
+  }
+  if (!Storage.openFileForRead("CSS", self->cachePath + rulesCache, self->tableFile)) {
+    return;
+  }
+
+  // The table came from this cache file, so lookups can continue from the card
+  const size_t tableBytes = self->rules.size() * sizeof(Rule);
+  self->fileRuleCount = static_cast<uint16_t>(self->rules.size());
+  std::vector<Rule>().swap(self->rules);
+  self->memo.reset();
+  MemBudget.release(MemoryBudget::Consumer::CSS, tableBytes);
+  self->reservedBytes -= tableBytes;
+}
+
+CssParser::~CssParser() { clear(); }
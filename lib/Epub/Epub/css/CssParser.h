@@ -2,8 +2,10 @@
 
 #include <HalStorage.h>
 
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -19,22 +21,42 @@
  * Supported selectors:
  *   - Element selectors: p, div, h1, etc.
  *   - Class selectors: .classname
- *   - Combined: element.classname
+ *   - Combined: element.classname, element.class1.class2
+ *   - Descendant and child chains: div.chapter p, .calibre1 > span
  *   - Grouped: selector1, selector2 { }
  *
  * Not supported (silently ignored):
- *   - Descendant/child selectors
+ *   - Sibling, attribute, ID and universal selectors
  *   - Pseudo-classes and pseudo-elements
  *   - Media queries (content is skipped)
  *   - @import, @font-face, etc.
+ *
+ * Rules are kept as a flat table of (selector hash, style, source order) records sorted by hash, and the cache file
+ * stores the same records verbatim. Loading the cache is a single block read, or, when the table does not fit in RAM,
+ * lookups binary search the cache file directly. Matching rules are applied by specificity, then source order.
+ * Resolved styles are memoized per (tag, class attribute) until the rules are cleared, which happens after every
+ * section build.
+ *
+ * Selectors that need more than the element's tag and one class are compiled right to left into chain rules,
+ * indexed by the subject's first class or tag. They are matched against the element's ancestor path, which the
+ * caller keeps as a stack of CssElementKey while streaming the document.
  */
+
+// Element as seen by selector chains: hashes of its tag and first classes
+struct CssElementKey {
+  static constexpr size_t MAX_CLASSES = 6;
+  uint32_t tagHash = 0;
+  uint8_t classCount = 0;
+  uint32_t classHashes[MAX_CLASSES] = {};
+};
+
 class CssParser {
  public:
   // Bump when CSS cache format or rules change; section caches are invalidated when this changes
-  static constexpr uint8_t CSS_CACHE_VERSION = 3;
+  static constexpr uint8_t CSS_CACHE_VERSION = 6;
 
   explicit CssParser(std::string cachePath) : cachePath(std::move(cachePath)) {}
-  ~CssParser() = default;
+  ~CssParser();
 
   // Non-copyable
   CssParser(const CssParser&) = delete;
@@ -50,13 +72,29 @@ class CssParser {
 
   /**
    * Look up the style for an HTML element, considering tag name and class attributes.
-   * Applies CSS cascade: element style < class style < element.class style
+   * Applies CSS cascade: element style < class style < element.class style, with later rules winning among equal
+   * specificity.
+   *
+   * Selector chains take part in the same order when the element's path is given.
    *
    * @param tagName The HTML element name (e.g., "p", "div")
    * @param classAttr The class attribute value (may contain multiple space-separated classes)
+   * @param path Keys of the document root down to and including this element, or nullptr
+   * @param pathLength Number of entries in path
    * @return Combined style with all applicable rules merged
    */
-  [[nodiscard]] CssStyle resolveStyle(const std::string& tagName, const std::string& classAttr) const;
+  [[nodiscard]] CssStyle resolveStyle(std::string_view tagName, std::string_view classAttr,
+                                      const CssElementKey* path = nullptr, size_t pathLength = 0) const;
+
+  /**
+   * Build the key of an element for its descendants' selector chains.
+   */
+  [[nodiscard]] static CssElementKey makeElementKey(std::string_view tagName, std::string_view classAttr);
+
+  /**
+   * Whether any selector chains were loaded, i.e. whether callers need to track element paths
+   */
+  [[nodiscard]] bool hasSelectorChains() const { return !chainRules.empty(); }
 
   /**
    * Parse an inline style attribute string.
@@ -68,17 +106,17 @@ class CssParser {
   /**
    * Check if any rules have been loaded
    */
-  [[nodiscard]] bool empty() const { return rulesBySelector_.empty(); }
+  [[nodiscard]] bool empty() const { return ruleCount() == 0; }
 
   /**
    * Get count of loaded rule sets
    */
-  [[nodiscard]] size_t ruleCount() const { return rulesBySelector_.size(); }
+  [[nodiscard]] size_t ruleCount() const { return tableFile ? fileRuleCount : rules.size(); }
 
   /**
    * Clear all loaded rules
    */
-  void clear() { rulesBySelector_.clear(); }
+  void clear();
 
   /**
    * Check if CSS rules cache file exists
@@ -104,11 +142,88 @@ class CssParser {
   bool loadFromCache();
 
  private:
-  // Storage: maps normalized selector -> style properties
-  std::unordered_map<std::string, CssStyle> rulesBySelector_;
+  // Compiled rule, also the fixed-size record of the cache file
+  struct Rule {
+    uint64_t selectorHash;  // FNV-1a of the normalized selector
+    CssStyle style;
+    uint16_t sourceOrder;  // Position of the selector's last definition across the book's stylesheets
+  };
+  static_assert(std::is_trivially_copyable<Rule>::value, "Rules are stored in the cache as raw records");
+
+  struct MemoEntry {
+    uint64_t key;  // Hash of tag and lowercased class attribute
+    bool valid;
+    CssStyle style;
+  };
+  static constexpr size_t MEMO_SIZE = 32;
+
+  static constexpr size_t MAX_CHAIN_COMPOUNDS = 4;
+  static constexpr size_t MAX_COMPOUND_CLASSES = 3;
+  enum Combinator : uint8_t { COMBINATOR_NONE = 0, COMBINATOR_DESCENDANT = 1, COMBINATOR_CHILD = 2 };
+
+  // Compound selector such as `div.note`, one link of a chain
+  struct Compound {
+    uint32_t tagHash;  // 0 matches any tag
+    uint32_t classHashes[MAX_COMPOUND_CLASSES];
+    uint8_t classCount;
+    uint8_t combinator;  // Relation to the next compound, which is further left in the selector
+  };
+
+  // Selector chain compiled right to left: compounds[0] is the subject. The style itself lives in the rule table.
+  struct ChainRule {
+    uint64_t selectorHash;  // Rule table key of the style
+    uint32_t subjectKey;    // First class of the subject, or its tag when it has no class
+    uint16_t specificity;   // 256 per class plus 1 per tag
+    uint8_t compoundCount;
+    Compound compounds[MAX_CHAIN_COMPOUNDS];
+  };
+  static_assert(std::is_trivially_copyable<ChainRule>::value, "Chain rules are stored in the cache as raw records");
+
+  // Rule that applies to an element, resolveUncached applies them by (specificity, sourceOrder)
+  struct RuleMatch {
+    uint16_t specificity;
+    uint16_t sourceOrder;
+    uint64_t selectorHash;
+  };
+
+  // Sorted by selectorHash
+  std::vector<Rule> rules;
+  // Open cache file when the table did not fit in RAM, lookups then binary search its records
+  mutable FsFile tableFile;
+  uint16_t fileRuleCount = 0;
+  // Next Rule::sourceOrder while parsing
+  uint16_t nextSourceOrder = 0;
+  // Bytes of both tables held under the CSS memory budget
+  size_t reservedBytes = 0;
+  bool pressureCallbackSet = false;  // onMemoryPressure registered with this as its context
+
+  // Direct-mapped resolveStyle memo, allocated on first use
+  mutable std::unique_ptr<MemoEntry[]> memo;
+  mutable uint32_t memoHits = 0;
+  mutable uint32_t memoMisses = 0;
+
+  // Sorted by subjectKey, always kept in RAM
+  std::vector<ChainRule> chainRules;
+  mutable uint32_t chainElements = 0;
+  mutable uint32_t chainMatches = 0;
+  mutable uint32_t chainBudgetHits = 0;
+  mutable unsigned long chainMicros = 0;
 
   std::string cachePath;
 
+  void addRule(uint64_t selectorHash, const CssStyle& style, uint16_t sourceOrder);
+  const Rule* lookupRule(uint64_t selectorHash, Rule& scratch) const;
+  bool findRule(uint64_t selectorHash, CssStyle& out) const;
+  static void onMemoryPressure(void* context, size_t bytesWanted);
+  CssStyle resolveUncached(uint64_t tagHash, std::string_view classAttr, const RuleMatch* chains = nullptr,
+                           size_t chainCount = 0) const;
+  bool addChainRule(const std::string& key, uint64_t selectorHash);
+  size_t matchChains(const CssElementKey* path, size_t pathLength, RuleMatch* matches) const;
+  static bool compileCompound(std::string_view text, Compound& out, uint16_t& specificity);
+  static bool compoundMatches(const Compound& compound, const CssElementKey& element);
+  static bool ancestorsMatch(const ChainRule& rule, size_t index, const CssElementKey* path, size_t position,
+                             int& budget);
+
   // Internal parsing helpers
   void processRuleBlockWithStyle(const std::string& selectorGroup, const CssStyle& style);
   static CssStyle parseDeclarations(const std::string& declBlock);
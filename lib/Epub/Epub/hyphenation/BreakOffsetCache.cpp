@@ -0,0 +1,28 @@
+#include "BreakOffsetCache.h"
+
+#include <algorithm>
+#include <iterator>
+
+const std::vector<Hyphenator::BreakInfo>& BreakOffsetCache::get(const std::string& word, const bool includeFallback) {
+  const auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry& entry) {
+    return entry.includeFallback == includeFallback && entry.word == word;
+  });
+  if (it != entries.end()) {
+    hits++;
+    entries.splice(entries.begin(), entries, it);
+    return entries.front().breaks;
+  }
+
+  misses++;
+  if (entries.size() >= CAPACITY) {
+    // Recycle the least recently used node to avoid a free/malloc pair per miss
+    entries.splice(entries.begin(), entries, std::prev(entries.end()));
+  } else {
+    entries.emplace_front();
+  }
+  Entry& entry = entries.front();
+  entry.word = word;
+  entry.includeFallback = includeFallback;
+  entry.breaks = Hyphenator::breakOffsets(word, includeFallback);
+  return entry.breaks;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "Hyphenator.h"
+
+/**
+ * Small LRU of Hyphenator::breakOffsets results for one chapter.
+ *
+ * Words that end up at a line end tend to be long and to recur through a chapter, and every attempt to split one
+ * runs the language trie again. The language is fixed while a chapter is laid out, so results only depend on the
+ * word and the fallback flag.
+ */
+class BreakOffsetCache {
+ public:
+  // Break offsets for word, computed on a miss. The reference stays valid until the next call.
+  const std::vector<Hyphenator::BreakInfo>& get(const std::string& word, bool includeFallback);
+
+  uint32_t getHits() const { return hits; }
+  uint32_t getMisses() const { return misses; }
+
+ private:
+  static constexpr size_t CAPACITY = 48;
+
+  struct Entry {
+    std::string word;
+    bool includeFallback;
+    std::vector<Hyphenator::BreakInfo> breaks;
+  };
+
+  std::list<Entry> entries;  // Most recently used first
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+};
@@ -6,15 +6,19 @@
 #include <functional>
 #include <memory>
 
+#include "../ImageManifest.h"
 #include "../ParsedText.h"
+#include "../WordWidthCache.h"
 #include "../blocks/ImageBlock.h"
 #include "../blocks/TextBlock.h"
 #include "../css/CssParser.h"
 #include "../css/CssStyle.h"
+#include "../hyphenation/BreakOffsetCache.h"
 
 class Page;
 class GfxRenderer;
 class Epub;
+struct ImageDimensions;
 
 #define MAX_WORD_SIZE 200
 
@@ -35,6 +39,9 @@ class ChapterHtmlSlimParser {
   int partWordBufferIndex = 0;
   bool nextWordContinues = false;  // true when next flushed word attaches to previous (inline element boundary)
   std::unique_ptr<ParsedText> currentTextBlock = nullptr;
+  // Layout caches, live for one parseAndBuildPages call
+  std::unique_ptr<WordWidthCache> wordWidthCache = nullptr;
+  std::unique_ptr<BreakOffsetCache> breakOffsetCache = nullptr;
   std::unique_ptr<Page> currentPage = nullptr;
   int16_t currentPageNextY = 0;
   int fontId;
@@ -47,8 +54,7 @@ class ChapterHtmlSlimParser {
   const CssParser* cssParser;
   bool embeddedStyle;
   std::string contentBase;
-  std::string imageBasePath;
-  int imageCounter = 0;
+  ImageManifest& imageManifest;
 
   // Style tracking (replaces depth-based approach)
   struct StyleStackEntry {
@@ -58,6 +64,9 @@ class ChapterHtmlSlimParser {
     bool hasUnderline = false, underline = false;
   };
   std::vector<StyleStackEntry> inlineStyleStack;
+  // Keys of the open elements indexed by depth, for CSS selector chains. Deeper elements are not tracked.
+  static constexpr size_t MAX_CSS_PATH_DEPTH = 32;
+  std::vector<CssElementKey> cssPath;
   CssStyle currentCssStyle;
   bool effectiveBold = false;
   bool effectiveItalic = false;
@@ -70,6 +79,8 @@ class ChapterHtmlSlimParser {
   void startNewTextBlock(const BlockStyle& blockStyle);
   void flushPartWordBuffer();
   void makePages();
+  bool extractImage(const std::string& zipPath, const std::string& ext, const std::string& cachedImagePath,
+                    ImageDimensions& dims);
   // XML callbacks
   static void XMLCALL startElement(void* userData, const XML_Char* name, const XML_Char** atts);
   static void XMLCALL characterData(void* userData, const XML_Char* s, int len);
@@ -83,7 +94,7 @@ class ChapterHtmlSlimParser {
                                  const uint16_t viewportHeight, const bool hyphenationEnabled,
                                  const std::function<void(std::unique_ptr<Page>)>& completePageFn,
                                  const bool embeddedStyle, const std::string& contentBase,
-                                 const std::string& imageBasePath, const std::function<void()>& popupFn = nullptr,
+                                 ImageManifest& imageManifest, const std::function<void()>& popupFn = nullptr,
                                  const CssParser* cssParser = nullptr)
 
       : epub(epub),
@@ -101,7 +112,7 @@ class ChapterHtmlSlimParser {
         cssParser(cssParser),
         embeddedStyle(embeddedStyle),
         contentBase(contentBase),
-        imageBasePath(imageBasePath) {}
+        imageManifest(imageManifest) {}
 
   ~ChapterHtmlSlimParser() = default;
   bool parseAndBuildPages();
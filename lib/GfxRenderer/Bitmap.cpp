@@ -177,45 +177,9 @@ BmpReaderError Bitmap::parseHeaders() {
   return BmpReaderError::Ok;
 }
 
-// packed 2bpp output, 0 = black, 1 = dark gray, 2 = light gray, 3 = white
-BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
-  // Note: rowBuffer should be pre-allocated by the caller to size 'rowBytes'
-  if (file.read(rowBuffer, rowBytes) != rowBytes) return BmpReaderError::ShortReadRow;
-
-  prevRowY += 1;
-
-  uint8_t* outPtr = data;
-  uint8_t currentOutByte = 0;
-  int bitShift = 6;
-  int currentX = 0;
-
-  // Helper lambda to pack 2bpp color into the output stream
-  auto packPixel = [&](const uint8_t lum) {
-    uint8_t color;
-    if (atkinsonDitherer) {
-      color = atkinsonDitherer->processPixel(adjustPixel(lum), currentX);
-    } else if (fsDitherer) {
-      color = fsDitherer->processPixel(adjustPixel(lum), currentX);
-    } else {
-      if (nativePalette) {
-        // Palette matches native gray levels: direct mapping (still apply brightness/contrast/gamma)
-        color = static_cast<uint8_t>(adjustPixel(lum) >> 6);
-      } else {
-        // Non-native palette with dithering disabled: simple quantization
-        color = quantize(adjustPixel(lum), currentX, prevRowY);
-      }
-    }
-    currentOutByte |= (color << bitShift);
-    if (bitShift == 0) {
-      *outPtr++ = currentOutByte;
-      currentOutByte = 0;
-      bitShift = 6;
-    } else {
-      bitShift -= 2;
-    }
-    currentX++;
-  };
-
+// Decode one raw row into 8-bit luminance, calling emit(lum) once per pixel from left to right
+template <typename Emit>
+BmpReaderError Bitmap::decodeRow(const uint8_t* rowBuffer, Emit&& emit) const {
   uint8_t lum;
 
   switch (bpp) {
@@ -223,7 +187,7 @@ BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
       const uint8_t* p = rowBuffer;
       for (int x = 0; x < width; x++) {
         lum = (77u * p[2] + 150u * p[1] + 29u * p[0]) >> 8;
-        packPixel(lum);
+        emit(lum);
         p += 4;
       }
       break;
@@ -232,28 +196,28 @@ BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
       const uint8_t* p = rowBuffer;
       for (int x = 0; x < width; x++) {
         lum = (77u * p[2] + 150u * p[1] + 29u * p[0]) >> 8;
-        packPixel(lum);
+        emit(lum);
         p += 3;
       }
       break;
     }
     case 8: {
       for (int x = 0; x < width; x++) {
-        packPixel(paletteLum[rowBuffer[x]]);
+        emit(paletteLum[rowBuffer[x]]);
       }
       break;
     }
     case 4: {
       for (int x = 0; x < width; x++) {
         const uint8_t nibble = (x & 1) ? (rowBuffer[x >> 1] & 0x0F) : (rowBuffer[x >> 1] >> 4);
-        packPixel(paletteLum[nibble]);
+        emit(paletteLum[nibble]);
       }
       break;
     }
     case 2: {
       for (int x = 0; x < width; x++) {
         lum = paletteLum[(rowBuffer[x >> 2] >> (6 - ((x & 3) * 2))) & 0x03];
-        packPixel(lum);
+        emit(lum);
       }
       break;
     }
@@ -263,13 +227,57 @@ BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
         const uint8_t palIndex = (rowBuffer[x >> 3] & (0x80 >> (x & 7))) ? 1 : 0;
         // Use palette lookup for proper black/white mapping
         lum = paletteLum[palIndex];
-        packPixel(lum);
+        emit(lum);
       }
       break;
     }
     default:
       return BmpReaderError::UnsupportedBpp;
   }
+  return BmpReaderError::Ok;
+}
+
+// packed 2bpp output, 0 = black, 1 = dark gray, 2 = light gray, 3 = white
+BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
+  // Note: rowBuffer should be pre-allocated by the caller to size 'rowBytes'
+  if (file.read(rowBuffer, rowBytes) != rowBytes) return BmpReaderError::ShortReadRow;
+
+  prevRowY += 1;
+
+  uint8_t* outPtr = data;
+  uint8_t currentOutByte = 0;
+  int bitShift = 6;
+  int currentX = 0;
+
+  // Helper lambda to pack 2bpp color into the output stream
+  auto packPixel = [&](const uint8_t lum) {
+    uint8_t color;
+    if (atkinsonDitherer) {
+      color = atkinsonDitherer->processPixel(adjustPixel(lum), currentX);
+    } else if (fsDitherer) {
+      color = fsDitherer->processPixel(adjustPixel(lum), currentX);
+    } else {
+      if (nativePalette) {
+        // Palette matches native gray levels: direct mapping (still apply brightness/contrast/gamma)
+        color = static_cast<uint8_t>(adjustPixel(lum) >> 6);
+      } else {
+        // Non-native palette with dithering disabled: simple quantization
+        color = quantize(adjustPixel(lum), currentX, prevRowY);
+      }
+    }
+    currentOutByte |= (color << bitShift);
+    if (bitShift == 0) {
+      *outPtr++ = currentOutByte;
+      currentOutByte = 0;
+      bitShift = 6;
+    } else {
+      bitShift -= 2;
+    }
+    currentX++;
+  };
+
+  const BmpReaderError err = decodeRow(rowBuffer, packPixel);
+  if (err != BmpReaderError::Ok) return err;
 
   if (atkinsonDitherer)
     atkinsonDitherer->nextRow();
@@ -282,6 +290,12 @@ BmpReaderError Bitmap::readNextRow(uint8_t* data, uint8_t* rowBuffer) const {
   return BmpReaderError::Ok;
 }
 
+Bitmap::Dither Bitmap::getDither() const {
+  if (atkinsonDitherer) return Dither::ATKINSON;
+  if (fsDitherer) return Dither::FLOYD_STEINBERG;
+  return Dither::NONE;
+}
+
 BmpReaderError Bitmap::rewindToData() const {
   if (!file.seek(bfOffBits)) {
     return BmpReaderError::SeekPixelDataFailed;
@@ -293,3 +307,14 @@ BmpReaderError Bitmap::rewindToData() const {
 
   return BmpReaderError::Ok;
 }
+
+// 8-bit luminance output, one byte per pixel, no dithering or tone adjustment
+BmpReaderError Bitmap::readNextRowLuminance(uint8_t* data, uint8_t* rowBuffer) const {
+  // Note: rowBuffer should be pre-allocated by the caller to size 'rowBytes', data to size 'width'
+  if (file.read(rowBuffer, rowBytes) != rowBytes) return BmpReaderError::ShortReadRow;
+
+  prevRowY += 1;
+
+  uint8_t* outPtr = data;
+  return decodeRow(rowBuffer, [&outPtr](const uint8_t lum) { *outPtr++ = lum; });
+}
@@ -30,12 +30,16 @@ enum class BmpReaderError : uint8_t {
 
 class Bitmap {
  public:
+  // Error diffusion readNextRow applies, picked by parseHeaders from the dithering flag and the palette
+  enum class Dither : uint8_t { NONE, ATKINSON, FLOYD_STEINBERG };
+
   static const char* errorToString(BmpReaderError err);
 
   explicit Bitmap(FsFile& file, bool dithering = false) : file(file), dithering(dithering) {}
   ~Bitmap();
   BmpReaderError parseHeaders();
   BmpReaderError readNextRow(uint8_t* data, uint8_t* rowBuffer) const;
+  BmpReaderError readNextRowLuminance(uint8_t* data, uint8_t* rowBuffer) const;
   BmpReaderError rewindToData() const;
   int getWidth() const { return width; }
   int getHeight() const { return height; }
@@ -44,10 +48,15 @@ class Bitmap {
   int getRowBytes() const { return rowBytes; }
   bool is1Bit() const { return bpp == 1; }
   uint16_t getBpp() const { return bpp; }
+  // For callers that resample readNextRowLuminance output and quantize it the way readNextRow would
+  Dither getDither() const;
+  bool hasNativePalette() const { return nativePalette; }
 
  private:
   static uint16_t readLE16(FsFile& f);
   static uint32_t readLE32(FsFile& f);
+  template <typename Emit>
+  BmpReaderError decodeRow(const uint8_t* rowBuffer, Emit&& emit) const;
 
   FsFile& file;
   bool dithering = false;
@@ -0,0 +1,240 @@
+#include "FramebufferImageCache.h"
+
+#include <Logging.h>
+#include <MemoryBudget.h>
+#include <PerfTrace.h>
+#include <Serialization.h>
+
+#include <cstring>
+
+namespace {
+constexpr uint8_t FRAMEBUFFER_CACHE_VERSION = 2;
+// version, orientation, source stamp, x, y, width, height, greyscale source, plane count
+constexpr size_t HEADER_SIZE = 1 + 1 + sizeof(uint32_t) + 4 * sizeof(int16_t) + 1 + 1;
+constexpr size_t PLANE_COUNT_OFFSET = HEADER_SIZE - 1;
+}  // namespace
+
+FramebufferImageCache::~FramebufferImageCache() {
+  if (file) {
+    file.close();
+  }
+  if (planes) {
+    free(planes);
+    MemBudget.release(MemoryBudget::Consumer::IMAGE_DECODE, planesBytes);
+  }
+}
+
+std::string FramebufferImageCache::pathFor(const std::string& bmpPath) {
+  const size_t dot = bmpPath.rfind('.');
+  return (dot == std::string::npos ? bmpPath : bmpPath.substr(0, dot)) + ".fbc";
+}
+
+bool FramebufferImageCache::open(const uint32_t sourceStamp) {
+  if (!Storage.exists(path.c_str()) || !Storage.openFileForRead("FBC", path, file)) {
+    return false;
+  }
+
+  uint8_t version = 0;
+  uint8_t orientation = 0;
+  serialization::readPod(file, version);
+  serialization::readPod(file, orientation);
+  if (version != FRAMEBUFFER_CACHE_VERSION) {
+    LOG_DBG("FBC", "Cache version mismatch (got %u, expected %u): %s", version, FRAMEBUFFER_CACHE_VERSION,
+            path.c_str());
+    file.close();
+    Storage.remove(path.c_str());
+    return false;
+  }
+  uint32_t stamp = 0;
+  serialization::readPod(file, stamp);
+  if (orientation != renderer.getOrientation() || stamp != sourceStamp) {
+    file.close();
+    return false;
+  }
+
+  serialization::readPod(file, x);
+  serialization::readPod(file, y);
+  serialization::readPod(file, width);
+  serialization::readPod(file, height);
+  serialization::readPod(file, greyscaleSource);
+  serialization::readPod(file, planeCount);
+
+  if (planeCount == 0 || planeCount > 3 || !renderer.getPhysicalRegion(x, y, width, height, &region) ||
+      file.size() != HEADER_SIZE + planeCount * planeSize()) {
+    LOG_ERR("FBC", "Invalid cache, removing: %s", path.c_str());
+    file.close();
+    Storage.remove(path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool FramebufferImageCache::loadPlanes() {
+  if (planes) {
+    return true;
+  }
+  if (!file || writing) {
+    return false;
+  }
+
+  const size_t bytes = planeCount * planeSize();
+  if (!MemBudget.tryReserve(MemoryBudget::Consumer::IMAGE_DECODE, bytes)) {
+    return false;
+  }
+  planes = static_cast<uint8_t*>(malloc(bytes));
+  if (!planes) {
+    MemBudget.release(MemoryBudget::Consumer::IMAGE_DECODE, bytes);
+    return false;
+  }
+
+  perf::Scope perfScope(perf::Metric::SD_READ);
+  perf::count(perf::Counter::SD_READ_BYTES, bytes);
+  if (!file.seek(HEADER_SIZE) || file.read(planes, bytes) != static_cast<int>(bytes)) {
+    LOG_ERR("FBC", "Failed to load planes: %s", path.c_str());
+    free(planes);
+    planes = nullptr;
+    MemBudget.release(MemoryBudget::Consumer::IMAGE_DECODE, bytes);
+    return false;
+  }
+  planesBytes = bytes;
+  file.close();
+  return true;
+}
+
+void FramebufferImageCache::copyRow(uint8_t* dst, const uint8_t* row) const {
+  const int last = region.byteWidth - 1;
+  dst[0] = (dst[0] & ~region.firstMask) | (row[0] & region.firstMask);
+  if (last > 0) {
+    memcpy(dst + 1, row + 1, last - 1);
+    dst[last] = (dst[last] & ~region.lastMask) | (row[last] & region.lastMask);
+  }
+}
+
+bool FramebufferImageCache::drawPlane(const Plane plane) {
+  uint8_t* frameBuffer = renderer.getFrameBuffer();
+  if ((!file && !planes) || writing || !hasPlane(plane) || !frameBuffer) {
+    return false;
+  }
+
+  uint8_t* dst = frameBuffer + region.y * HalDisplay::DISPLAY_WIDTH_BYTES + region.byteX;
+  // Full-width region: the plane is a contiguous slice of the framebuffer
+  const bool contiguous =
+      region.byteWidth == HalDisplay::DISPLAY_WIDTH_BYTES && region.firstMask == 0xFF && region.lastMask == 0xFF;
+
+  if (planes) {
+    const uint8_t* src = planes + plane * planeSize();
+    if (contiguous) {
+      memcpy(dst, src, planeSize());
+      return true;
+    }
+    for (int r = 0; r < region.rows; r++, dst += HalDisplay::DISPLAY_WIDTH_BYTES, src += region.byteWidth) {
+      copyRow(dst, src);
+    }
+    return true;
+  }
+
+  if (!file.seek(HEADER_SIZE + plane * planeSize())) {
+    return false;
+  }
+  perf::Scope perfScope(perf::Metric::SD_READ);
+  perf::count(perf::Counter::SD_READ_BYTES, planeSize());
+
+  if (contiguous) {
+    return file.read(dst, planeSize()) == static_cast<int>(planeSize());
+  }
+
+  uint8_t row[HalDisplay::DISPLAY_WIDTH_BYTES];
+  for (int r = 0; r < region.rows; r++, dst += HalDisplay::DISPLAY_WIDTH_BYTES) {
+    if (file.read(row, region.byteWidth) != region.byteWidth) {
+      LOG_ERR("FBC", "Short read in plane %u row %d", plane, r);
+      return false;
+    }
+    copyRow(dst, row);
+  }
+  return true;
+}
+
+bool FramebufferImageCache::beginWrite(const int x, const int y, const int width, const int height,
+                                       const bool greyscaleSource, const uint32_t sourceStamp) {
+  if (file) {
+    file.close();
+  }
+  if (!renderer.getPhysicalRegion(x, y, width, height, &region)) {
+    LOG_DBG("FBC", "Rect %d,%d %dx%d is not cacheable", x, y, width, height);
+    return false;
+  }
+  if (!Storage.openFileForWrite("FBC", path, file)) {
+    return false;
+  }
+
+  this->x = static_cast<int16_t>(x);
+  this->y = static_cast<int16_t>(y);
+  this->width = static_cast<int16_t>(width);
+  this->height = static_cast<int16_t>(height);
+  this->greyscaleSource = greyscaleSource;
+  planeCount = 0;
+  writing = true;
+
+  serialization::writePod(file, FRAMEBUFFER_CACHE_VERSION);
+  serialization::writePod(file, static_cast<uint8_t>(renderer.getOrientation()));
+  serialization::writePod(file, sourceStamp);
+  serialization::writePod(file, this->x);
+  serialization::writePod(file, this->y);
+  serialization::writePod(file, this->width);
+  serialization::writePod(file, this->height);
+  serialization::writePod(file, this->greyscaleSource);
+  // Plane count is patched in finishWrite, so an interrupted capture is rejected on open
+  serialization::writePod(file, planeCount);
+  return true;
+}
+
+bool FramebufferImageCache::writePlaneData(const Plane plane, const uint8_t* data) {
+  if (!writing || plane != planeCount) {
+    return false;
+  }
+  if (file.write(data, planeSize()) != planeSize()) {
+    return false;
+  }
+  planeCount++;
+  return true;
+}
+
+bool FramebufferImageCache::writePlane(const Plane plane) {
+  const uint8_t* frameBuffer = renderer.getFrameBuffer();
+  if (!writing || plane != planeCount || !frameBuffer) {
+    return false;
+  }
+
+  const uint8_t* src = frameBuffer + region.y * HalDisplay::DISPLAY_WIDTH_BYTES + region.byteX;
+  if (region.byteWidth == HalDisplay::DISPLAY_WIDTH_BYTES) {
+    if (file.write(src, planeSize()) != planeSize()) {
+      return false;
+    }
+  } else {
+    for (int r = 0; r < region.rows; r++, src += HalDisplay::DISPLAY_WIDTH_BYTES) {
+      if (file.write(src, region.byteWidth) != static_cast<size_t>(region.byteWidth)) {
+        return false;
+      }
+    }
+  }
+  planeCount++;
+  return true;
+}
+
+bool FramebufferImageCache::finishWrite() {
+  if (!writing) {
+    return false;
+  }
+  writing = false;
+
+  const bool ok = planeCount > 0 && file.seek(PLANE_COUNT_OFFSET) && file.write(&planeCount, 1) == 1;
+  file.close();
+  if (!ok) {
+    LOG_ERR("FBC", "Failed to write cache: %s", path.c_str());
+    Storage.remove(path.c_str());
+    return false;
+  }
+
+  LOG_DBG("FBC", "Cached %dx%d image with %u plane(s): %s", width, height, planeCount, path.c_str());
+  return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <HalStorage.h>
+
+#include <cstdint>
+#include <string>
+
+#include "GfxRenderer.h"
+
+/**
+ * Rendered image cached in native framebuffer layout (.fbc).
+ *
+ * Holds the framebuffer bytes covering a logical rect exactly as GfxRenderer left them after drawing a bitmap: the
+ * BW plane and, for grayscale sources, the LSB and MSB planes. Drawing a cached image is a block read per physical
+ * row straight into the framebuffer (a single read for full-width regions), with no BMP parsing, scaling or
+ * dithering. A cache is only valid for the orientation and rect it was captured with.
+ *
+ * When one image is drawn in several render passes, loadPlanes keeps all planes in RAM so later passes are a memcpy.
+ */
+class FramebufferImageCache {
+ public:
+  enum Plane : uint8_t { BW_PLANE = 0, GRAYSCALE_LSB_PLANE = 1, GRAYSCALE_MSB_PLANE = 2 };
+
+  FramebufferImageCache(const GfxRenderer& renderer, std::string path) : renderer(renderer), path(std::move(path)) {}
+  ~FramebufferImageCache();
+
+  // Cache path for a rendered BMP, stored next to it
+  static std::string pathFor(const std::string& bmpPath);
+  const std::string& getPath() const { return path; }
+
+  // Open an existing cache. Fails if it is missing, corrupt, or was captured in another orientation or under another
+  // source stamp.
+  bool open(uint32_t sourceStamp = 0);
+  int getX() const { return x; }
+  int getY() const { return y; }
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+  bool hasPlane(const Plane plane) const { return plane < planeCount; }
+  // Whether the source bitmap had gray levels, i.e. whether the grayscale planes are meaningful
+  bool isGreyscaleSource() const { return greyscaleSource; }
+  // Read every plane into memory (under the image decode budget) and close the file
+  bool loadPlanes();
+  // Copy a plane into the framebuffer, leaving pixels outside the rect untouched
+  bool drawPlane(Plane plane);
+
+  // Capture planes from the framebuffer, in BW, LSB, MSB order, after drawing each pass
+  bool beginWrite(int x, int y, int width, int height, bool greyscaleSource, uint32_t sourceStamp = 0);
+  bool writePlane(Plane plane);
+  // Or write planes built elsewhere, laid out as getRegion() describes: byteWidth bytes per physical row
+  bool writePlaneData(Plane plane, const uint8_t* data);
+  bool finishWrite();
+  const GfxRenderer::PhysicalRegion& getRegion() const { return region; }
+
+ private:
+  const GfxRenderer& renderer;
+  std::string path;
+  FsFile file;
+  GfxRenderer::PhysicalRegion region = {};
+  int16_t x = 0;
+  int16_t y = 0;
+  int16_t width = 0;
+  int16_t height = 0;
+  bool greyscaleSource = false;
+  uint8_t planeCount = 0;
+  bool writing = false;
+  uint8_t* planes = nullptr;  // All planes after loadPlanes
+  size_t planesBytes = 0;
+
+  void copyRow(uint8_t* dst, const uint8_t* row) const;
+  size_t planeSize() const { return static_cast<size_t>(region.byteWidth) * region.rows; }
+};
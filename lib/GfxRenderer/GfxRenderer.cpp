@@ -1,8 +1,14 @@
 #include "GfxRenderer.h"
 
 #include <Logging.h>
+#include <MemoryBudget.h>
 #include <Utf8.h>
 
+#include <algorithm>
+#include <memory>
+
+#include "GlyphAtlas.h"
+
 const uint8_t* GfxRenderer::getGlyphBitmap(const EpdFontData* fontData, const EpdGlyph* glyph) const {
   if (fontData->groups != nullptr) {
     if (!fontDecompressor) {
@@ -61,23 +67,24 @@ static inline void rotateCoordinates(const GfxRenderer::Orientation orientation,
 
 enum class TextRotation { None, Rotated90CW };
 
-// Shared glyph rendering logic for normal and rotated text.
-// Coordinate mapping and cursor advance direction are selected at compile time via the template parameter.
-template <TextRotation rotation>
-static void renderCharImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode renderMode,
-                           const EpdFontFamily& fontFamily, const uint32_t cp, int* cursorX, int* cursorY,
-                           const bool pixelState, const EpdFontFamily::Style style) {
+static const EpdGlyph* resolveGlyph(const EpdFontFamily& fontFamily, const uint32_t cp,
+                                   const EpdFontFamily::Style style) {
   const EpdGlyph* glyph = fontFamily.getGlyph(cp, style);
   if (!glyph) {
     glyph = fontFamily.getGlyph(REPLACEMENT_GLYPH, style);
   }
-
   if (!glyph) {
     LOG_ERR("GFX", "No glyph for codepoint %d", cp);
-    return;
   }
+  return glyph;
+}
 
-  const EpdFontData* fontData = fontFamily.getData(style);
+// Shared glyph drawing logic for normal and rotated text, the cursor is not advanced.
+// Coordinate mapping is selected at compile time via the template parameter.
+template <TextRotation rotation>
+static void drawGlyphImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode renderMode,
+                          const EpdFontData* fontData, const EpdGlyph* glyph, const int cursorX, const int cursorY,
+                          const bool pixelState) {
   const bool is2Bit = fontData->is2Bit;
   const uint8_t width = glyph->width;
   const uint8_t height = glyph->height;
@@ -91,11 +98,11 @@ static void renderCharImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode
     // For Rotated: outer loop advances screenX, inner loop advances screenY (in reverse)
     int outerBase, innerBase;
     if constexpr (rotation == TextRotation::Rotated90CW) {
-      outerBase = *cursorX + fontData->ascender - top;  // screenX = outerBase + glyphY
-      innerBase = *cursorY - left;                      // screenY = innerBase - glyphX
+      outerBase = cursorX + fontData->ascender - top;  // screenX = outerBase + glyphY
+      innerBase = cursorY - left;                      // screenY = innerBase - glyphX
     } else {
-      outerBase = *cursorY - top;   // screenY = outerBase + glyphY
-      innerBase = *cursorX + left;  // screenX = innerBase + glyphX
+      outerBase = cursorY - top;   // screenY = outerBase + glyphY
+      innerBase = cursorX + left;  // screenX = innerBase + glyphX
     }
 
     if (is2Bit) {
@@ -156,6 +163,19 @@ static void renderCharImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode
       }
     }
   }
+}
+
+// Draw one codepoint and advance the cursor
+template <TextRotation rotation>
+static void renderCharImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode renderMode,
+                           const EpdFontFamily& fontFamily, const uint32_t cp, int* cursorX, int* cursorY,
+                           const bool pixelState, const EpdFontFamily::Style style) {
+  const EpdGlyph* glyph = resolveGlyph(fontFamily, cp, style);
+  if (!glyph) {
+    return;
+  }
+
+  drawGlyphImpl<rotation>(renderer, renderMode, fontFamily.getData(style), glyph, *cursorX, *cursorY, pixelState);
 
   if constexpr (rotation == TextRotation::Rotated90CW) {
     *cursorY -= glyph->advanceX;
@@ -231,6 +251,222 @@ void GfxRenderer::drawText(const int fontId, const int x, const int y, const cha
   }
 }
 
+void GfxRenderer::drawTextLine(const int fontId, const int y, const TextRun* runs, const size_t runCount,
+                               const bool black) const {
+  const auto fontIt = fontMap.find(fontId);
+  if (fontIt == fontMap.end()) {
+    LOG_ERR("GFX", "Font %d not found", fontId);
+    return;
+  }
+  const auto& font = fontIt->second;
+  const int baseline = y + getFontAscenderSize(fontId);
+
+  // Lay the line out into a draw list, then draw it sorted by (font, group). Every glyph only sets pixels of one
+  // color for the current render mode, so the draw order does not change the result, while drawing in visual order
+  // would decompress a group again each time bold, italic and regular alternate.
+  struct DrawItem {
+    const EpdFontData* fontData;
+    const EpdGlyph* glyph;
+    int x;
+    uint16_t groupIndex;
+  };
+  DrawItem items[MAX_LINE_GLYPHS];
+  size_t itemCount = 0;
+
+  const auto drawItems = [&] {
+    std::stable_sort(items, items + itemCount, [](const DrawItem& a, const DrawItem& b) {
+      return a.fontData != b.fontData ? a.fontData < b.fontData : a.groupIndex < b.groupIndex;
+    });
+    for (size_t i = 0; i < itemCount; i++) {
+      drawGlyphImpl<TextRotation::None>(*this, renderMode, items[i].fontData, items[i].glyph, items[i].x, baseline,
+                                        black);
+    }
+    itemCount = 0;
+  };
+
+  for (size_t r = 0; r < runCount; r++) {
+    const TextRun& run = runs[r];
+    if (run.text == nullptr) {
+      continue;
+    }
+    const EpdFontData* fontData = font.getData(run.style);
+    const auto* text = reinterpret_cast<const uint8_t*>(run.text);
+    int xPos = run.x;
+    uint32_t cp;
+    while ((cp = utf8NextCodepoint(&text))) {
+      const EpdGlyph* glyph = resolveGlyph(font, cp, run.style);
+      if (!glyph) {
+        continue;
+      }
+      if (itemCount == MAX_LINE_GLYPHS) {
+        drawItems();  // Unusually long line, draw it in chunks
+      }
+      const uint16_t groupIndex =
+          fontData->groups ? FontDecompressor::getGroupIndex(fontData, static_cast<uint16_t>(glyph - fontData->glyph))
+                           : 0;
+      items[itemCount++] = {fontData, glyph, xPos, groupIndex};
+      xPos += glyph->advanceX;
+    }
+  }
+  drawItems();
+}
+
+bool GfxRenderer::buildGlyphAtlas(const int fontId, const char* chars, GlyphAtlas& atlas,
+                                  const EpdFontFamily::Style style) const {
+  const auto fontIt = fontMap.find(fontId);
+  if (fontIt == fontMap.end()) {
+    LOG_ERR("GFX", "Font %d not found", fontId);
+    return false;
+  }
+  const auto& font = fontIt->second;
+  const EpdFontData* fontData = font.getData(style);
+
+  atlas.fontId = fontId;
+  atlas.style = style;
+  atlas.orientation = orientation;
+  atlas.ascender = getFontAscenderSize(fontId);
+  atlas.tiles.clear();
+  atlas.bits.clear();
+
+  uint32_t cp;
+  while ((cp = utf8NextCodepoint(reinterpret_cast<const uint8_t**>(&chars)))) {
+    if (std::any_of(atlas.tiles.begin(), atlas.tiles.end(), [cp](const GlyphAtlas::Tile& t) { return t.cp == cp; })) {
+      continue;
+    }
+    const EpdGlyph* glyph = font.getGlyph(cp, style);
+    if (!glyph) {
+      continue;  // Left to the regular path, which draws the replacement glyph
+    }
+
+    GlyphAtlas::Tile tile = {};
+    tile.cp = cp;
+    tile.left = glyph->left;
+    tile.top = glyph->top;
+    tile.width = glyph->width;
+    tile.height = glyph->height;
+    tile.advanceX = glyph->advanceX;
+    tile.offset = atlas.bits.size();
+
+    if (glyph->width > 0 && glyph->height > 0) {
+      const uint8_t* bitmap = getGlyphBitmap(fontData, glyph);
+      if (!bitmap) {
+        continue;
+      }
+
+      // Panel footprint of the glyph box, from the rotation of its corners placed at the logical origin
+      int x0, y0, x1, y1;
+      rotateCoordinates(orientation, 0, 0, &x0, &y0);
+      rotateCoordinates(orientation, glyph->width - 1, glyph->height - 1, &x1, &y1);
+      const int minX = std::min(x0, x1);
+      const int minY = std::min(y0, y1);
+      tile.physWidth = std::abs(x1 - x0) + 1;
+      tile.physHeight = std::abs(y1 - y0) + 1;
+      tile.rowBytes = (tile.physWidth + 7) / 8;
+      atlas.bits.resize(tile.offset + tile.rowBytes * tile.physHeight, 0);
+
+      // Keep the pixels drawText would paint in BW mode (for 2-bit fonts: every non-white level)
+      uint8_t* tileBits = atlas.bits.data() + tile.offset;
+      int pixelPosition = 0;
+      for (int glyphY = 0; glyphY < glyph->height; glyphY++) {
+        for (int glyphX = 0; glyphX < glyph->width; glyphX++, pixelPosition++) {
+          const bool set = fontData->is2Bit ? (bitmap[pixelPosition >> 2] >> ((3 - (pixelPosition & 3)) * 2)) & 0x3
+                                            : (bitmap[pixelPosition >> 3] >> (7 - (pixelPosition & 7))) & 1;
+          if (!set) continue;
+          int phyX, phyY;
+          rotateCoordinates(orientation, glyphX, glyphY, &phyX, &phyY);
+          phyX -= minX;
+          phyY -= minY;
+          tileBits[phyY * tile.rowBytes + phyX / 8] |= 0x80 >> (phyX % 8);
+        }
+      }
+    }
+    atlas.tiles.push_back(tile);
+  }
+
+  std::sort(atlas.tiles.begin(), atlas.tiles.end(),
+            [](const GlyphAtlas::Tile& a, const GlyphAtlas::Tile& b) { return a.cp < b.cp; });
+  LOG_DBG("GFX", "Glyph atlas for font %d: %u glyphs, %u bytes", fontId, static_cast<unsigned>(atlas.tiles.size()),
+          static_cast<unsigned>(atlas.bits.size()));
+  return atlas.isBuilt();
+}
+
+void GfxRenderer::drawAtlasText(const GlyphAtlas& atlas, const int x, const int y, const char* text,
+                                const bool black) const {
+  if (text == nullptr || *text == '\0') {
+    return;
+  }
+  // Tiles only hold the BW plane in the orientation they were built for
+  if (renderMode != BW || atlas.orientation != orientation || !atlas.isBuilt()) {
+    drawText(atlas.fontId, x, y, text, black, atlas.style);
+    return;
+  }
+
+  const int baseline = y + atlas.ascender;
+  int cursorX = x;
+  uint32_t cp;
+  while ((cp = utf8NextCodepoint(reinterpret_cast<const uint8_t**>(&text)))) {
+    const GlyphAtlas::Tile* tile = atlas.findTile(cp);
+    if (!tile) {
+      const auto fontIt = fontMap.find(atlas.fontId);
+      if (fontIt != fontMap.end()) {
+        int yPos = baseline;
+        renderChar(fontIt->second, cp, &cursorX, &yPos, black, atlas.style);
+      }
+      continue;
+    }
+
+    if (tile->physWidth > 0) {
+      // Panel position of the glyph box, then each tile row is shifted into at most rowBytes + 1 framebuffer bytes
+      const int boxX = cursorX + tile->left;
+      const int boxY = baseline - tile->top;
+      int x0, y0, x1, y1;
+      rotateCoordinates(orientation, boxX, boxY, &x0, &y0);
+      rotateCoordinates(orientation, boxX + tile->width - 1, boxY + tile->height - 1, &x1, &y1);
+      const int phyX = std::min(x0, x1);
+      const int phyY = std::min(y0, y1);
+      const int byteX = phyX >> 3;  // Floor, so a box hanging off the left edge still lines up
+      const int shift = phyX & 7;
+
+      const uint8_t* src = atlas.bits.data() + tile->offset;
+      for (int row = 0; row < tile->physHeight; row++, src += tile->rowBytes) {
+        const int py = phyY + row;
+        if (py < 0 || py >= HalDisplay::DISPLAY_HEIGHT) continue;
+        uint8_t* dst = frameBuffer + py * HalDisplay::DISPLAY_WIDTH_BYTES;
+        for (int b = 0; b <= tile->rowBytes; b++) {
+          const uint8_t hi = b < tile->rowBytes ? src[b] >> shift : 0;
+          const uint8_t lo = b > 0 && shift ? static_cast<uint8_t>(src[b - 1] << (8 - shift)) : 0;
+          const uint8_t mask = hi | lo;
+          const int bx = byteX + b;
+          if (!mask || bx < 0 || bx >= HalDisplay::DISPLAY_WIDTH_BYTES) continue;
+          if (black) {
+            dst[bx] &= ~mask;
+          } else {
+            dst[bx] |= mask;
+          }
+        }
+      }
+    }
+    cursorX += tile->advanceX;
+  }
+}
+
+int GfxRenderer::getAtlasTextWidth(const GlyphAtlas& atlas, const char* text) const {
+  // Same bounds as EpdFont::getTextDimensions, from the tile metrics
+  int minX = 0, maxX = 0, cursorX = 0;
+  uint32_t cp;
+  const char* p = text;
+  while ((cp = utf8NextCodepoint(reinterpret_cast<const uint8_t**>(&p)))) {
+    const GlyphAtlas::Tile* tile = atlas.findTile(cp);
+    if (!tile) {
+      return getTextWidth(atlas.fontId, text, atlas.style);
+    }
+    minX = std::min(minX, cursorX + tile->left);
+    maxX = std::max(maxX, cursorX + tile->left + tile->width);
+    cursorX += tile->advanceX;
+  }
+  return maxX - minX;
+}
+
 void GfxRenderer::drawLine(int x1, int y1, int x2, int y2, const bool state) const {
   if (x1 == x2) {
     if (y2 < y1) {
@@ -567,6 +803,11 @@ void GfxRenderer::drawBitmap(const Bitmap& bitmap, const int x, const int y, con
   }
   LOG_DBG("GFX", "Scaling by %f - %s", scale, isScaled ? "scaled" : "not scaled");
 
+  if (isScaled) {
+    drawBitmapAreaAveraged(bitmap, x, y, scale, cropPixX, cropPixY);
+    return;
+  }
+
   // Calculate output row size (2 bits per pixel, packed into bytes)
   // IMPORTANT: Use int, not uint8_t, to avoid overflow for images > 1020 pixels wide
   const int outputRowSize = (bitmap.getWidth() + 3) / 4;
@@ -584,10 +825,7 @@ void GfxRenderer::drawBitmap(const Bitmap& bitmap, const int x, const int y, con
     // The BMP's (0, 0) is the bottom-left corner (if the height is positive, top-left if negative).
     // Screen's (0, 0) is the top-left corner.
     int screenY = -cropPixY + (bitmap.isTopDown() ? bmpY : bitmap.getHeight() - 1 - bmpY);
-    if (isScaled) {
-      screenY = std::floor(screenY * scale);
-    }
-    screenY += y;  // the offset should not be scaled
+    screenY += y;
     if (screenY >= getScreenHeight()) {
       break;
     }
@@ -609,11 +847,7 @@ void GfxRenderer::drawBitmap(const Bitmap& bitmap, const int x, const int y, con
     }
 
     for (int bmpX = cropPixX; bmpX < bitmap.getWidth() - cropPixX; bmpX++) {
-      int screenX = bmpX - cropPixX;
-      if (isScaled) {
-        screenX = std::floor(screenX * scale);
-      }
-      screenX += x;  // the offset should not be scaled
+      const int screenX = bmpX - cropPixX + x;
       if (screenX >= getScreenWidth()) {
         break;
       }
@@ -637,6 +871,168 @@ void GfxRenderer::drawBitmap(const Bitmap& bitmap, const int x, const int y, con
   free(rowBytes);
 }
 
+// Downscale by area averaging (box filter) instead of point sampling. Source rows are read once as undithered
+// luminance and accumulated into a single destination row with exact fixed-point coverage weights: source pixel i
+// spans [i * dstW, (i + 1) * dstW) and destination pixel d spans [d * srcW, (d + 1) * srcW), so a source pixel
+// contributes to at most two destination pixels per axis. Completed destination rows are dithered once at output
+// resolution, which avoids the moire of sampling an already dithered source. The ditherer, or the quantization when
+// the bitmap is not dithered, is the one drawBitmap gets from readNextRow.
+void GfxRenderer::drawBitmapAreaAveraged(const Bitmap& bitmap, const int x, const int y, const float scale,
+                                         const int cropPixX, const int cropPixY) const {
+  const int srcW = bitmap.getWidth() - 2 * cropPixX;
+  const int srcH = bitmap.getHeight() - 2 * cropPixY;
+  if (srcW <= 0 || srcH <= 0) {
+    return;
+  }
+  const int dstW = std::min(srcW, std::max(1, static_cast<int>(std::floor(srcW * scale))));
+  const int dstH = std::min(srcH, std::max(1, static_cast<int>(std::floor(srcH * scale))));
+
+  // Only destination columns that land on screen are accumulated, from the source columns that overlap them
+  const int dstXStart = std::max(0, -x);
+  const int dstXEnd = std::min(dstW, getScreenWidth() - x);
+  if (dstXStart >= dstXEnd) {
+    return;
+  }
+  const int srcXStart = dstXStart * srcW / dstW;
+  const int srcXEnd = std::min(srcW, (dstXEnd * srcW + dstW - 1) / dstW);
+  const int visibleW = dstXEnd - dstXStart;
+
+  // Worst case accumulator value is 255 * srcW * srcH, which fits in 32 bits for the largest supported bitmap
+  const uint32_t totalWeight = static_cast<uint32_t>(srcW) * static_cast<uint32_t>(srcH);
+  auto* lumRow = static_cast<uint8_t*>(malloc(bitmap.getWidth()));
+  auto* rowBytes = static_cast<uint8_t*>(malloc(bitmap.getRowBytes()));
+  auto* rowSum = static_cast<uint32_t*>(malloc((dstW + 1) * sizeof(uint32_t)));
+  auto* acc = static_cast<uint32_t*>(calloc(dstW + 1, sizeof(uint32_t)));
+
+  if (!lumRow || !rowBytes || !rowSum || !acc) {
+    LOG_ERR("GFX", "!! Failed to allocate BMP downscale buffers");
+    free(lumRow);
+    free(rowBytes);
+    free(rowSum);
+    free(acc);
+    return;
+  }
+
+  std::unique_ptr<AtkinsonDitherer> atkinson;
+  std::unique_ptr<FloydSteinbergDitherer> floydSteinberg;
+  switch (bitmap.getDither()) {
+    case Bitmap::Dither::ATKINSON:
+      atkinson = std::make_unique<AtkinsonDitherer>(visibleW);
+      break;
+    case Bitmap::Dither::FLOYD_STEINBERG:
+      floydSteinberg = std::make_unique<FloydSteinbergDitherer>(visibleW);
+      break;
+    case Bitmap::Dither::NONE:
+      break;
+  }
+  int dstRow = 0;     // Destination row being accumulated, in file read order
+  int rowPos = 0;     // Start of the current source row in destination-scaled units
+  int rowEnd = srcH;  // End of the destination row being accumulated
+  bool ok = true;
+
+  for (int bmpY = 0; bmpY < cropPixY + srcH && dstRow < dstH; bmpY++) {
+    if (bitmap.readNextRowLuminance(lumRow, rowBytes) != BmpReaderError::Ok) {
+      LOG_ERR("GFX", "Failed to read row %d from bitmap", bmpY);
+      ok = false;
+      break;
+    }
+    if (bmpY < cropPixY) {
+      continue;
+    }
+
+    // Horizontal pass: fold the source row into destination columns
+    memset(rowSum, 0, (dstW + 1) * sizeof(uint32_t));
+    int col = srcXStart * dstW / srcW;
+    int colEnd = (col + 1) * srcW;
+    int pos = srcXStart * dstW;
+    for (int srcX = srcXStart; srcX < srcXEnd; srcX++) {
+      const uint32_t lum = lumRow[cropPixX + srcX];
+      const int end = pos + dstW;
+      rowSum[col] += static_cast<uint32_t>(std::min(end, colEnd) - pos) * lum;
+      if (end >= colEnd) {
+        col++;
+        if (end > colEnd) {
+          rowSum[col] += static_cast<uint32_t>(end - colEnd) * lum;
+        }
+        colEnd += srcW;
+      }
+      pos = end;
+    }
+
+    // Vertical pass: the source row may complete the current destination row and spill into the next one
+    const int end = rowPos + dstH;
+    const uint32_t topWeight = std::min(end, rowEnd) - rowPos;
+    for (int d = dstXStart; d < dstXEnd; d++) {
+      acc[d] += topWeight * rowSum[d];
+    }
+    rowPos = end;
+    if (end < rowEnd) {
+      continue;
+    }
+
+    const int screenY = y + (bitmap.isTopDown() ? dstRow : dstH - 1 - dstRow);
+    if (bitmap.isTopDown() && screenY >= getScreenHeight()) {
+      break;
+    }
+
+    // Dither the completed row at output resolution, 0 = black ... 3 = white, and draw it straight away. Rows above
+    // or below the screen are still dithered to carry their error. Floyd-Steinberg runs serpentine, so its odd rows
+    // are walked right to left.
+    const bool visibleRow = screenY >= 0 && screenY < getScreenHeight();
+    const bool reverse = floydSteinberg && floydSteinberg->isReverseRow();
+    for (int n = 0; n < visibleW; n++) {
+      const int i = reverse ? visibleW - 1 - n : n;
+      const int gray = adjustPixel(static_cast<int>((acc[dstXStart + i] + totalWeight / 2) / totalWeight));
+      uint8_t val;
+      if (atkinson) {
+        val = atkinson->processPixel(gray, i);
+      } else if (floydSteinberg) {
+        val = floydSteinberg->processPixel(gray, i);
+      } else if (bitmap.hasNativePalette()) {
+        val = static_cast<uint8_t>(gray >> 6);
+      } else {
+        val = quantize(gray, dstXStart + i, dstRow);
+      }
+
+      if (!visibleRow) {
+        continue;
+      }
+      const int screenX = x + dstXStart + i;
+      if (renderMode == BW && val < 3) {
+        drawPixel(screenX, screenY);
+      } else if (renderMode == GRAYSCALE_MSB && (val == 1 || val == 2)) {
+        drawPixel(screenX, screenY, false);
+      } else if (renderMode == GRAYSCALE_LSB && val == 1) {
+        drawPixel(screenX, screenY, false);
+      }
+    }
+    if (atkinson) {
+      atkinson->nextRow();
+    } else if (floydSteinberg) {
+      floydSteinberg->nextRow();
+    }
+
+    dstRow++;
+    rowEnd += srcH;
+    memset(acc, 0, (dstW + 1) * sizeof(uint32_t));
+    if (end > rowEnd - srcH) {
+      const uint32_t bottomWeight = end - (rowEnd - srcH);
+      for (int d = dstXStart; d < dstXEnd; d++) {
+        acc[d] += bottomWeight * rowSum[d];
+      }
+    }
+  }
+
+  if (ok) {
+    LOG_DBG("GFX", "Area-averaged %dx%d -> %dx%d", srcW, srcH, dstW, dstH);
+  }
+
+  free(lumRow);
+  free(rowBytes);
+  free(rowSum);
+  free(acc);
+}
+
 void GfxRenderer::drawBitmap1Bit(const Bitmap& bitmap, const int x, const int y, const int maxWidth,
                                  const int maxHeight) const {
   float scale = 1.0f;
@@ -791,9 +1187,35 @@ void GfxRenderer::invertScreen() const {
 void GfxRenderer::displayBuffer(const HalDisplay::RefreshMode refreshMode) const {
   auto elapsed = millis() - start_ms;
   LOG_DBG("GFX", "Time = %lu ms from clearScreen to displayBuffer", elapsed);
+  refreshPlanner.recordRefresh(frameBuffer, refreshMode);
   display.displayBuffer(refreshMode, fadingFix);
 }
 
+void GfxRenderer::displayChanges() const {
+  const RefreshPlanner::Plan plan = refreshPlanner.plan(frameBuffer);
+  switch (plan.action) {
+    case RefreshPlanner::Plan::NONE:
+      break;
+    case RefreshPlanner::Plan::WINDOW:
+      display.displayWindow(plan.x, plan.y, plan.width, plan.height, fadingFix);
+      break;
+    case RefreshPlanner::Plan::SCREEN:
+      display.displayBuffer(plan.mode, fadingFix);
+      break;
+  }
+}
+
+void GfxRenderer::displayWindow(const int x, const int y, const int width, const int height) const {
+  PhysicalRegion region;
+  if (!getPhysicalRegion(x, y, width, height, &region)) {
+    LOG_ERR("GFX", "Window %dx%d at (%d,%d) is outside the screen", width, height, x, y);
+    return;
+  }
+  // Changes outside the window stay off the panel, so the tile hashes no longer describe it
+  refreshPlanner.invalidate();
+  display.displayWindow(region.byteX * 8, region.y, region.byteWidth * 8, region.rows, fadingFix);
+}
+
 std::string GfxRenderer::truncatedText(const int fontId, const char* text, const int maxWidth,
                                        const EpdFontFamily::Style style) const {
   if (!text || maxWidth <= 0) return "";
@@ -871,6 +1293,29 @@ int GfxRenderer::getTextAdvanceX(const int fontId, const char* text, const EpdFo
   return width;
 }
 
+void GfxRenderer::getTextPrefixAdvances(const int fontId, const std::string& text, const EpdFontFamily::Style style,
+                                        std::vector<uint16_t>& prefixAdvances) const {
+  prefixAdvances.assign(text.size() + 1, 0);
+  const auto fontIt = fontMap.find(fontId);
+  if (fontIt == fontMap.end()) {
+    LOG_ERR("GFX", "Font %d not found", fontId);
+    return;
+  }
+
+  constexpr uint32_t SOFT_HYPHEN = 0x00AD;
+  const auto& font = fontIt->second;
+  // Bounded walk: parsed words can end inside a codepoint, whose partial tail measures as the replacement glyph
+  utf8PrefixAdvances(
+      text,
+      [&font, style](const uint32_t cp) {
+        if (cp == SOFT_HYPHEN) return 0;
+        const EpdGlyph* glyph = font.getGlyph(cp, style);
+        if (!glyph) glyph = font.getGlyph(REPLACEMENT_GLYPH, style);
+        return glyph ? static_cast<int>(glyph->advanceX) : 0;
+      },
+      prefixAdvances);
+}
+
 int GfxRenderer::getFontAscenderSize(const int fontId) const {
   const auto fontIt = fontMap.find(fontId);
   if (fontIt == fontMap.end()) {
@@ -928,6 +1373,35 @@ uint8_t* GfxRenderer::getFrameBuffer() const { return frameBuffer; }
 
 size_t GfxRenderer::getBufferSize() { return HalDisplay::BUFFER_SIZE; }
 
+bool GfxRenderer::getPhysicalRegion(const int x, const int y, const int width, const int height,
+                                    PhysicalRegion* region) const {
+  if (width <= 0 || height <= 0 || x < 0 || y < 0 || x + width > getScreenWidth() || y + height > getScreenHeight()) {
+    return false;
+  }
+
+  int phyX0, phyY0, phyX1, phyY1;
+  rotateCoordinates(orientation, x, y, &phyX0, &phyY0);
+  rotateCoordinates(orientation, x + width - 1, y + height - 1, &phyX1, &phyY1);
+  const int minX = std::min(phyX0, phyX1);
+  const int maxX = std::max(phyX0, phyX1);
+
+  region->byteX = minX / 8;
+  region->byteWidth = maxX / 8 - region->byteX + 1;
+  region->y = std::min(phyY0, phyY1);
+  region->rows = std::max(phyY0, phyY1) - region->y + 1;
+  region->firstMask = 0xFF >> (minX % 8);
+  region->lastMask = 0xFF << (7 - maxX % 8);
+  if (region->byteWidth == 1) {
+    region->firstMask &= region->lastMask;
+    region->lastMask = region->firstMask;
+  }
+  return true;
+}
+
+void GfxRenderer::getPhysicalPixel(const int x, const int y, int* phyX, int* phyY) const {
+  rotateCoordinates(orientation, x, y, phyX, phyY);
+}
+
 // unused
 // void GfxRenderer::grayscaleRevert() const { display.grayscaleRevert(); }
 
@@ -935,7 +1409,10 @@ void GfxRenderer::copyGrayscaleLsbBuffers() const { display.copyGrayscaleLsbBuff
 
 void GfxRenderer::copyGrayscaleMsbBuffers() const { display.copyGrayscaleMsbBuffers(frameBuffer); }
 
-void GfxRenderer::displayGrayBuffer() const { display.displayGrayBuffer(fadingFix); }
+void GfxRenderer::displayGrayBuffer() const {
+  refreshPlanner.invalidate();
+  display.displayGrayBuffer(fadingFix);
+}
 
 void GfxRenderer::freeBwBufferChunks() {
   for (auto& bwBufferChunk : bwBufferChunks) {
@@ -944,6 +1421,10 @@ void GfxRenderer::freeBwBufferChunks() {
       bwBufferChunk = nullptr;
     }
   }
+  if (bwBufferReserved) {
+    MemBudget.release(MemoryBudget::Consumer::FRAMEBUFFER, HalDisplay::BUFFER_SIZE);
+    bwBufferReserved = false;
+  }
 }
 
 /**
@@ -953,6 +1434,14 @@ void GfxRenderer::freeBwBufferChunks() {
  * Returns true if buffer was stored successfully, false if allocation failed.
  */
 bool GfxRenderer::storeBwBuffer() {
+  if (!bwBufferReserved) {
+    if (!MemBudget.tryReserve(MemoryBudget::Consumer::FRAMEBUFFER, HalDisplay::BUFFER_SIZE, BW_BUFFER_CHUNK_SIZE)) {
+      LOG_ERR("GFX", "!! No memory budget for BW buffer (%zu bytes)", HalDisplay::BUFFER_SIZE);
+      return false;
+    }
+    bwBufferReserved = true;
+  }
+
   // Allocate and copy each chunk
   for (size_t i = 0; i < BW_BUFFER_NUM_CHUNKS; i++) {
     // Check if any chunks are already allocated
@@ -5,8 +5,13 @@
 #include <HalDisplay.h>
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include "Bitmap.h"
+#include "RefreshPlanner.h"
+
+class GlyphAtlas;
 
 // Color representation: uint8_t mapped to 4x4 Bayer matrix dithering levels
 // 0 = transparent, 1-16 = gray levels (white to black)
@@ -25,6 +30,7 @@ class GfxRenderer {
   };
 
  private:
+  static constexpr size_t MAX_LINE_GLYPHS = 96;  // drawTextLine draw list, on the stack
   static constexpr size_t BW_BUFFER_CHUNK_SIZE = 8000;  // 8KB chunks to allow for non-contiguous memory
   static constexpr size_t BW_BUFFER_NUM_CHUNKS = HalDisplay::BUFFER_SIZE / BW_BUFFER_CHUNK_SIZE;
   static_assert(BW_BUFFER_CHUNK_SIZE * BW_BUFFER_NUM_CHUNKS == HalDisplay::BUFFER_SIZE,
@@ -36,11 +42,14 @@ class GfxRenderer {
   bool fadingFix;
   uint8_t* frameBuffer = nullptr;
   uint8_t* bwBufferChunks[BW_BUFFER_NUM_CHUNKS] = {nullptr};
+  bool bwBufferReserved = false;  // Chunks are held under the framebuffer memory budget
   std::map<int, EpdFontFamily> fontMap;
   FontDecompressor* fontDecompressor = nullptr;
+  mutable RefreshPlanner refreshPlanner;  // Follows every refresh, including those of const display calls
   void renderChar(const EpdFontFamily& fontFamily, uint32_t cp, int* x, int* y, bool pixelState,
                   EpdFontFamily::Style style) const;
   void freeBwBufferChunks();
+  void drawBitmapAreaAveraged(const Bitmap& bitmap, int x, int y, float scale, int cropPixX, int cropPixY) const;
   template <Color color>
   void drawPixelDither(int x, int y) const;
   template <Color color>
@@ -75,8 +84,15 @@ class GfxRenderer {
   int getScreenWidth() const;
   int getScreenHeight() const;
   void displayBuffer(HalDisplay::RefreshMode refreshMode = HalDisplay::FAST_REFRESH) const;
-  // EXPERIMENTAL: Windowed update - display only a rectangular region
-  // void displayWindow(int x, int y, int width, int height) const;
+  // Windowed update: refresh only the panel area under a logical rect, widened to whole framebuffer bytes
+  void displayWindow(int x, int y, int width, int height) const;
+  // Refresh what changed since the last refresh, letting RefreshPlanner pick the mode and window from the changed
+  // tiles and the ghosting built up by fast refreshes. Skips the refresh when nothing changed.
+  void displayChanges() const;
+  // Fast refreshes of this many whole screens between half refreshes, for displayChanges
+  void setRefreshBudget(const int screensPerHalfRefresh) { refreshPlanner.setBudget(screensPerHalfRefresh); }
+  // Make the next displayChanges a half refresh, e.g. when a reader opens over another screen's ghosting
+  void requestHalfRefresh() { refreshPlanner.requestHalfRefresh(); }
   void invertScreen() const;
   void clearScreen(uint8_t color = 0xFF) const;
   void getOrientedViewableTRBL(int* outTop, int* outRight, int* outBottom, int* outLeft) const;
@@ -109,8 +125,26 @@ class GfxRenderer {
                         EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
   void drawText(int fontId, int x, int y, const char* text, bool black = true,
                 EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
+  // Words of one line sharing a top y, drawn as drawText would but with each compressed glyph group of the line
+  // decompressed once
+  struct TextRun {
+    int x;
+    const char* text;
+    EpdFontFamily::Style style;
+  };
+  void drawTextLine(int fontId, int y, const TextRun* runs, size_t runCount, bool black = true) const;
+  // Glyph atlas (see GlyphAtlas.h): rasterize the glyphs of chars once for the current orientation, then draw text
+  // made of them as byte blits. Characters missing from the atlas go through the regular glyph path.
+  bool buildGlyphAtlas(int fontId, const char* chars, GlyphAtlas& atlas,
+                       EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
+  void drawAtlasText(const GlyphAtlas& atlas, int x, int y, const char* text, bool black = true) const;
+  int getAtlasTextWidth(const GlyphAtlas& atlas, const char* text) const;
   int getSpaceWidth(int fontId, EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
   int getTextAdvanceX(int fontId, const char* text, EpdFontFamily::Style style) const;
+  // Cumulative advances of text: prefixAdvances[i] is the advance width of text[0, i) at every codepoint boundary i
+  // (bytes inside a sequence hold the width before it). Soft hyphens are invisible and add no width.
+  void getTextPrefixAdvances(int fontId, const std::string& text, EpdFontFamily::Style style,
+                             std::vector<uint16_t>& prefixAdvances) const;
   int getFontAscenderSize(int fontId) const;
   int getLineHeight(int fontId) const;
   std::string truncatedText(int fontId, const char* text, int maxWidth,
@@ -137,4 +171,18 @@ class GfxRenderer {
   // Low level functions
   uint8_t* getFrameBuffer() const;
   static size_t getBufferSize();
+
+  // Framebuffer bytes covering a logical rect in the current orientation. Edge masks select the bits of the first
+  // and last byte of each row that belong to the rect (MSB is the leftmost pixel).
+  struct PhysicalRegion {
+    int byteX;
+    int byteWidth;
+    int y;
+    int rows;
+    uint8_t firstMask;
+    uint8_t lastMask;
+  };
+  bool getPhysicalRegion(int x, int y, int width, int height, PhysicalRegion* region) const;
+  // Panel coordinates of a logical pixel in the current orientation
+  void getPhysicalPixel(int x, int y, int* phyX, int* phyY) const;
 };
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "GfxRenderer.h"
+
+/**
+ * A chosen set of glyphs of one font and style, pre-rasterized into packed 1-bit tiles in framebuffer layout.
+ *
+ * Built once with GfxRenderer::buildGlyphAtlas for text that is drawn over and over in fixed cells (the game grid,
+ * keyboard keys). Drawing a glyph from the atlas is a shifted OR/AND of a few bytes per physical row, with no font
+ * lookup, group decompression or per-pixel rotation. Tiles are laid out for the orientation the atlas was built in;
+ * in any other orientation, and in grayscale passes, GfxRenderer falls back to the regular text path.
+ */
+class GlyphAtlas {
+ public:
+  bool isBuilt() const { return !tiles.empty(); }
+  size_t getGlyphCount() const { return tiles.size(); }
+  size_t getBitmapBytes() const { return bits.size(); }
+  // Rows the glyphs' ink spans relative to the y passed to drawAtlasText, bottom exclusive; 0/0 when nothing is built
+  void getInkRows(int* top, int* bottom) const {
+    *top = 0;
+    *bottom = 0;
+    for (size_t i = 0; i < tiles.size(); i++) {
+      const int tileTop = ascender - tiles[i].top;
+      *top = i == 0 ? tileTop : std::min(*top, tileTop);
+      *bottom = i == 0 ? tileTop + tiles[i].height : std::max(*bottom, tileTop + tiles[i].height);
+    }
+  }
+
+ private:
+  friend class GfxRenderer;
+
+  struct Tile {
+    uint32_t cp;
+    uint32_t offset;   // Into bits; rowBytes * physHeight bytes, MSB is the leftmost physical pixel
+    int16_t left;      // Glyph metrics, as in EpdGlyph
+    int16_t top;
+    uint8_t width;
+    uint8_t height;
+    uint8_t advanceX;
+    uint8_t physWidth;  // Glyph box in panel pixels
+    uint8_t physHeight;
+    uint8_t rowBytes;
+  };
+
+  // Tiles are sorted by codepoint
+  const Tile* findTile(const uint32_t cp) const {
+    const auto it = std::lower_bound(tiles.begin(), tiles.end(), cp,
+                                     [](const Tile& tile, const uint32_t c) { return tile.cp < c; });
+    return it != tiles.end() && it->cp == cp ? &*it : nullptr;
+  }
+
+  int fontId = -1;
+  EpdFontFamily::Style style = EpdFontFamily::REGULAR;
+  GfxRenderer::Orientation orientation = GfxRenderer::Portrait;
+  int ascender = 0;
+  std::vector<Tile> tiles;
+  std::vector<uint8_t> bits;
+};
@@ -0,0 +1,103 @@
+#include "RefreshPlanner.h"
+
+#include <Logging.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+// A window refresh is only worth it while its box stays under this share of the screen, in tiles
+constexpr int WINDOW_MAX_TILES = RefreshPlanner::TILE_COUNT / 3;
+
+uint32_t hashTile(const uint8_t* tile) {
+  // FNV-1a over 32-bit words, TILE_BYTES is a multiple of 4
+  uint32_t hash = 2166136261u;
+  for (int row = 0; row < RefreshPlanner::TILE_ROWS; row++, tile += HalDisplay::DISPLAY_WIDTH_BYTES) {
+    for (int i = 0; i < RefreshPlanner::TILE_BYTES; i += 4) {
+      uint32_t word;
+      memcpy(&word, tile + i, sizeof(word));
+      hash = (hash ^ word) * 16777619u;
+    }
+  }
+  return hash;
+}
+}  // namespace
+
+void RefreshPlanner::setBudget(const int screensPerHalfRefresh) {
+  budget = screensPerHalfRefresh > 1 ? (screensPerHalfRefresh - 1) * TILE_COUNT : 0;
+}
+
+int RefreshPlanner::update(const uint8_t* frameBuffer, int* col0, int* band0, int* col1, int* band1) {
+  *col0 = TILE_COLS;
+  *band0 = TILE_BANDS;
+  *col1 = -1;
+  *band1 = -1;
+  int changed = 0;
+  for (int band = 0; band < TILE_BANDS; band++) {
+    const uint8_t* row = frameBuffer + band * TILE_ROWS * HalDisplay::DISPLAY_WIDTH_BYTES;
+    for (int col = 0; col < TILE_COLS; col++) {
+      const uint32_t hash = hashTile(row + col * TILE_BYTES);
+      uint32_t& shownHash = shown[band * TILE_COLS + col];
+      if (shownValid && hash == shownHash) continue;
+      shownHash = hash;
+      changed++;
+      *col0 = std::min(*col0, col);
+      *col1 = std::max(*col1, col);
+      *band0 = std::min(*band0, band);
+      *band1 = std::max(*band1, band);
+    }
+  }
+  shownValid = true;
+  return changed;
+}
+
+RefreshPlanner::Plan RefreshPlanner::plan(const uint8_t* frameBuffer) {
+  const bool wasValid = shownValid;
+  int col0, band0, col1, band1;
+  const int changed = update(frameBuffer, &col0, &band0, &col1, &band1);
+
+  Plan result;
+  if (changed == 0 && !halfRefreshPending) {
+    LOG_DBG("RFP", "Frame unchanged, no refresh");
+    return result;
+  }
+
+  if (halfRefreshPending || debt + changed > budget) {
+    result.action = Plan::SCREEN;
+    result.mode = HalDisplay::HALF_REFRESH;
+    result.width = HalDisplay::DISPLAY_WIDTH;
+    result.height = HalDisplay::DISPLAY_HEIGHT;
+    debt = 0;
+    halfRefreshPending = false;
+  } else {
+    const int boxTiles = (col1 - col0 + 1) * (band1 - band0 + 1);
+    if (wasValid && boxTiles <= WINDOW_MAX_TILES) {
+      result.action = Plan::WINDOW;
+      result.x = col0 * TILE_BYTES * 8;
+      result.y = band0 * TILE_ROWS;
+      result.width = (col1 - col0 + 1) * TILE_BYTES * 8;
+      result.height = (band1 - band0 + 1) * TILE_ROWS;
+    } else {
+      result.action = Plan::SCREEN;
+      result.width = HalDisplay::DISPLAY_WIDTH;
+      result.height = HalDisplay::DISPLAY_HEIGHT;
+    }
+    debt += changed;
+  }
+  LOG_DBG("RFP", "%d/%d tiles changed, %s %s, debt %lu/%lu", changed, TILE_COUNT,
+          result.action == Plan::WINDOW ? "window" : "screen",
+          result.mode == HalDisplay::HALF_REFRESH ? "half" : "fast", static_cast<unsigned long>(debt),
+          static_cast<unsigned long>(budget));
+  return result;
+}
+
+void RefreshPlanner::recordRefresh(const uint8_t* frameBuffer, const HalDisplay::RefreshMode mode) {
+  int col0, band0, col1, band1;
+  const int changed = update(frameBuffer, &col0, &band0, &col1, &band1);
+  if (mode == HalDisplay::FAST_REFRESH) {
+    debt += changed;
+  } else {
+    debt = 0;
+    halfRefreshPending = false;
+  }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <HalDisplay.h>
+
+#include <cstdint>
+
+/**
+ * Tracks what the panel shows and picks how to refresh the framebuffer onto it.
+ *
+ * The panel is split into tiles of TILE_ROWS physical rows by TILE_BYTES framebuffer bytes, and the planner keeps
+ * one hash per tile of the last frame sent to the panel (600 bytes instead of a 48 KB copy). Comparing the next
+ * frame's hashes gives the changed box and the changed share of the screen. Every fast refresh adds the tiles it
+ * changed to a ghosting debt; once the debt passes the budget, the next refresh is a HALF_REFRESH of the whole
+ * screen, which clears it.
+ */
+class RefreshPlanner {
+ public:
+  static constexpr int TILE_ROWS = 16;
+  static constexpr int TILE_BYTES = 20;
+  static constexpr int TILE_COLS = HalDisplay::DISPLAY_WIDTH_BYTES / TILE_BYTES;
+  static constexpr int TILE_BANDS = HalDisplay::DISPLAY_HEIGHT / TILE_ROWS;
+  static constexpr int TILE_COUNT = TILE_COLS * TILE_BANDS;
+  static_assert(TILE_COLS * TILE_BYTES == HalDisplay::DISPLAY_WIDTH_BYTES, "Refresh tiles must span the panel width");
+  static_assert(TILE_BANDS * TILE_ROWS == HalDisplay::DISPLAY_HEIGHT, "Refresh tiles must span the panel height");
+
+  // What to send: nothing, a fast refresh of a panel window (x and width in whole bytes), or the whole screen
+  struct Plan {
+    enum Action : uint8_t { NONE, WINDOW, SCREEN } action = NONE;
+    HalDisplay::RefreshMode mode = HalDisplay::FAST_REFRESH;
+    uint16_t x = 0;
+    uint16_t y = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+  };
+
+  // Fast refreshes of this many whole screens are allowed between half refreshes; 1 makes every refresh a half one
+  void setBudget(int screensPerHalfRefresh);
+  // Make the next plan a half refresh of the whole screen
+  void requestHalfRefresh() { halfRefreshPending = true; }
+  // Forget what the panel shows (e.g. after a grayscale pass or a windowed update), so the next plan covers it all
+  void invalidate() { shownValid = false; }
+
+  // Plan the refresh of frameBuffer and record it as shown
+  Plan plan(const uint8_t* frameBuffer);
+  // Record a refresh the caller chose itself
+  void recordRefresh(const uint8_t* frameBuffer, HalDisplay::RefreshMode mode);
+
+ private:
+  uint32_t shown[TILE_COUNT] = {};
+  bool shownValid = false;
+  bool halfRefreshPending = false;
+  uint32_t debt = 0;                  // Tiles fast-refreshed since the last half or full refresh
+  uint32_t budget = 14 * TILE_COUNT;  // Matches the default of a half refresh every 15 pages
+
+  // Hash frameBuffer into shown, returning the number of changed tiles and their bounding box in tiles
+  int update(const uint8_t* frameBuffer, int* col0, int* band0, int* col1, int* band1);
+};
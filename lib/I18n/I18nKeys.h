@@ -355,6 +355,7 @@ enum class StrId : uint16_t {
   STR_UPLOAD,
   STR_BOOK_S_STYLE,
   STR_EMBEDDED_STYLE,
+  STR_PRERENDER_IMAGES,
   STR_OPDS_SERVER_URL,
   // Sentinel - must be last
   _COUNT
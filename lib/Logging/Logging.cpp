@@ -1,47 +1,523 @@
 #include "Logging.h"
 
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <cstdarg>
+#include <cstring>
+
+#ifdef ENABLE_SERIAL_LOG
+namespace {
+constexpr size_t RING_SLOTS = 32;  // Must be a power of two
+constexpr size_t ARG_BYTES = 80;  // Strings are copied, so paths need room
+constexpr size_t LINE_SIZE = 256;
+constexpr size_t BATCH_SIZE = 512;
+constexpr char ERR_LEVEL[] = "[ERR]";
+static_assert((RING_SLOTS & (RING_SLOTS - 1)) == 0, "RING_SLOTS must be a power of two");
+
+// How a conversion's argument is passed through va_args, and so how it is stored in a record
+enum class ArgType : uint8_t { NONE, INT, LONG, LONG_LONG, SIZE, DOUBLE, STRING, POINTER, UNSUPPORTED };
+
+struct Spec {
+  const char* start;  // The '%'
+  size_t length;      // Up to and including the conversion character
+  ArgType type;
+  uint8_t stars;  // '*' width and precision, each taking an int argument first
+};
+
+// Parse the conversion starting at the '%' in p
+Spec parseSpec(const char* p) {
+  Spec spec = {p, 0, ArgType::UNSUPPORTED, 0};
+  const char* c = p + 1;
+  if (*c == '%') {
+    spec.length = 2;
+    spec.type = ArgType::NONE;
+    return spec;
+  }
+  while (*c && strchr("-+ #0", *c)) c++;
+  if (*c == '*') {
+    spec.stars++;
+    c++;
+  }
+  while (*c >= '0' && *c <= '9') c++;
+  if (*c == '.') {
+    c++;
+    if (*c == '*') {
+      spec.stars++;
+      c++;
+    }
+    while (*c >= '0' && *c <= '9') c++;
+  }
+
+  ArgType integer = ArgType::INT;
+  if (c[0] == 'h') {
+    c += c[1] == 'h' ? 2 : 1;  // Promoted to int
+  } else if (c[0] == 'l' && c[1] == 'l') {
+    integer = ArgType::LONG_LONG;
+    c += 2;
+  } else if (c[0] == 'l') {
+    integer = ArgType::LONG;
+    c++;
+  } else if (c[0] == 'j') {
+    integer = ArgType::LONG_LONG;
+    c++;
+  } else if (c[0] == 'z' || c[0] == 't') {
+    integer = ArgType::SIZE;
+    c++;
+  } else if (c[0] == 'L') {
+    return spec;  // long double is never logged
+  }
+
+  if (!*c) {
+    return spec;
+  }
+  if (strchr("diouxXc", *c)) {
+    spec.type = integer;
+  } else if (strchr("fFeEgGaA", *c)) {
+    spec.type = ArgType::DOUBLE;
+  } else if (*c == 's') {
+    spec.type = ArgType::STRING;
+  } else if (*c == 'p') {
+    spec.type = ArgType::POINTER;
+  }
+  spec.length = c + 1 - p;
+  return spec;
+}
+
+struct Record {
+  uint32_t timestamp;
+  const char* level;
+  const char* origin;
+  const char* format;
+  uint8_t argLength;
+  uint8_t args[ARG_BYTES];  // When they did not fit, the message stops at the first missing argument
+};
+
+// Arguments are packed in format order, in the type va_arg read them as
+class ArgWriter {
+ public:
+  explicit ArgWriter(Record& record) : record(record) {}
+
+  template <typename T>
+  bool put(const T value) {
+    if (record.argLength + sizeof(T) > ARG_BYTES) {
+      return false;
+    }
+    memcpy(record.args + record.argLength, &value, sizeof(T));
+    record.argLength += sizeof(T);
+    return true;
+  }
+
+  bool putString(const char* value) {
+    if (!value) {
+      value = "(null)";
+    }
+    const size_t room = ARG_BYTES - record.argLength;
+    if (room == 0) {
+      return false;
+    }
+    const size_t length = strnlen(value, room - 1);
+    memcpy(record.args + record.argLength, value, length);
+    record.args[record.argLength + length] = '\0';
+    record.argLength += length + 1;
+    return true;
+  }
+
+ private:
+  Record& record;
+};
+
+class ArgReader {
+ public:
+  explicit ArgReader(const Record& record) : record(record) {}
+
+  template <typename T>
+  bool get(T& value) {
+    if (offset + sizeof(T) > record.argLength) {
+      return false;
+    }
+    memcpy(&value, record.args + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+  }
+
+  bool getString(const char*& value) {
+    if (offset >= record.argLength) {
+      return false;
+    }
+    value = reinterpret_cast<const char*>(record.args + offset);
+    offset += strlen(value) + 1;
+    return true;
+  }
+
+ private:
+  const Record& record;
+  size_t offset = 0;
+};
+
+// Bounded multi-producer queue (Vyukov): producers claim a slot by advancing enqueuePos, and publish it through the
+// slot's sequence. The single consumer is serialized by serialLock.
+struct Slot {
+  std::atomic<uint32_t> sequence;
+  Record record;
+};
+
+class LogRing {
+ public:
+  LogRing() {
+    for (size_t i = 0; i < RING_SLOTS; i++) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  Record* claim(uint32_t& position) {
+    position = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = slots[position & (RING_SLOTS - 1)];
+      const auto diff = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - position);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          return &slot.record;
+        }
+      } else if (diff < 0) {
+        return nullptr;  // Full
+      } else {
+        position = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void publish(const uint32_t position) {
+    slots[position & (RING_SLOTS - 1)].sequence.store(position + 1, std::memory_order_release);
+  }
+
+  const Record* peek() {
+    Slot& slot = slots[dequeuePos & (RING_SLOTS - 1)];
+    const auto diff = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - (dequeuePos + 1));
+    return diff < 0 ? nullptr : &slot.record;
+  }
+
+  void pop() {
+    slots[dequeuePos & (RING_SLOTS - 1)].sequence.store(dequeuePos + RING_SLOTS, std::memory_order_release);
+    dequeuePos++;
+  }
+
+  std::atomic<uint32_t> dropped{0};
+
+ private:
+  Slot slots[RING_SLOTS];
+  std::atomic<uint32_t> enqueuePos{0};
+  uint32_t dequeuePos = 0;
+};
+
+LogRing ring;
+SemaphoreHandle_t serialLock = nullptr;
+TaskHandle_t drainTask = nullptr;
+uint32_t reportedDrops = 0;
+
+template <typename T>
+int formatArg(char* out, const size_t size, const char* spec, const int* stars, const uint8_t starCount,
+              const T value) {
+  switch (starCount) {
+    case 0:
+      return snprintf(out, size, spec, value);
+    case 1:
+      return snprintf(out, size, spec, stars[0], value);
+    default:
+      return snprintf(out, size, spec, stars[0], stars[1], value);
+  }
+}
+
+// Expand one conversion from the record's arguments, false when they ran out
+bool formatSpec(const Spec& spec, ArgReader& reader, char* out, const size_t size, int& written) {
+  int stars[2] = {};
+  for (uint8_t i = 0; i < spec.stars; i++) {
+    if (!reader.get(stars[i])) {
+      return false;
+    }
+  }
+  char format[16];
+  if (spec.length >= sizeof(format)) {
+    return false;
+  }
+  memcpy(format, spec.start, spec.length);
+  format[spec.length] = '\0';
+
+  switch (spec.type) {
+    case ArgType::INT: {
+      int value;
+      if (!reader.get(value)) return false;
+      written = formatArg(out, size, format, stars, spec.stars, value);
+      return true;
+    }
+    case ArgType::LONG: {
+      long value;
+      if (!reader.get(value)) return false;
+      written = formatArg(out, size, format, stars, spec.stars, value);
+      return true;
+    }
+    case ArgType::LONG_LONG: {
+      long long value;
+      if (!reader.get(value)) return false;
+      written = formatArg(out, size, format, stars, spec.stars, value);
+      return true;
+    }
+    case ArgType::SIZE: {
+      size_t value;
+      if (!reader.get(value)) return false;
+      written = formatArg(out, size, format, stars, spec.stars, value);
+      return true;
+    }
+    case ArgType::DOUBLE: {
+      double value;
+      if (!reader.get(value)) return false;
+      written = formatArg(out, size, format, stars, spec.stars, value);
+      return true;
+    }
+    case ArgType::STRING: {
+      const char* value;
+      if (!reader.getString(value)) return false;
+      written = formatArg(out, size, format, stars, spec.stars, value);
+      return true;
+    }
+    case ArgType::POINTER: {
+      const void* value;
+      if (!reader.get(value)) return false;
+      written = formatArg(out, size, format, stars, spec.stars, value);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
 // Since logging can take a large amount of flash, we want to make the format string as short as possible.
-// This logPrintf prepend the timestamp, level and origin to the user-provided message, so that the user only needs to
+// The timestamp, level and origin are prepended to the user-provided message, so that the user only needs to
 // provide the format string for the message itself.
+size_t formatRecord(const Record& record, char* line) {
+  size_t length = 0;
+  const int header = snprintf(line, LINE_SIZE, "[%lu] %s [%s] ", static_cast<unsigned long>(record.timestamp),
+                              record.level, record.origin);
+  if (header < 0) {
+    return 0;
+  }
+  length = header < static_cast<int>(LINE_SIZE) ? header : LINE_SIZE - 1;
+
+  ArgReader reader(record);
+  const char* p = record.format;
+  while (*p && length < LINE_SIZE - 1) {
+    if (*p != '%') {
+      line[length++] = *p++;
+      continue;
+    }
+    const Spec spec = parseSpec(p);
+    if (spec.type == ArgType::NONE) {
+      line[length++] = '%';
+      p += spec.length;
+      continue;
+    }
+    int written = 0;
+    if (!formatSpec(spec, reader, line + length, LINE_SIZE - length, written) || written < 0) {
+      // Arguments were truncated or the conversion is unsupported: end the line here
+      const char* ellipsis = "...\n";
+      while (*ellipsis && length < LINE_SIZE - 1) line[length++] = *ellipsis++;
+      break;
+    }
+    length += static_cast<size_t>(written) < LINE_SIZE - length ? written : LINE_SIZE - 1 - length;
+    p += spec.length;
+  }
+  line[length] = '\0';
+  return length;
+}
+
+// Format queued records into batches and write them, caller holds serialLock
+void drainRing() {
+  char batch[BATCH_SIZE];
+  char line[LINE_SIZE];
+  size_t batchLength = 0;
+
+  const auto flushBatch = [&] {
+    if (batchLength > 0) {
+      logSerial.write(reinterpret_cast<const uint8_t*>(batch), batchLength);
+      batchLength = 0;
+    }
+  };
+  const auto append = [&](const size_t length) {
+    if (batchLength + length > BATCH_SIZE) {
+      flushBatch();
+    }
+    memcpy(batch + batchLength, line, length);
+    batchLength += length;
+  };
+
+  while (const Record* record = ring.peek()) {
+    const size_t length = formatRecord(*record, line);
+    ring.pop();
+    append(length);
+  }
+
+  const uint32_t dropped = ring.dropped.load(std::memory_order_relaxed);
+  if (dropped != reportedDrops) {
+    const int length = snprintf(line, LINE_SIZE, "[%lu] [ERR] [LOG] Ring full, dropped %lu records\n",
+                                static_cast<unsigned long>(millis()),
+                                static_cast<unsigned long>(dropped - reportedDrops));
+    reportedDrops = dropped;
+    if (length > 0) {
+      append(static_cast<size_t>(length) < LINE_SIZE ? length : LINE_SIZE - 1);
+    }
+  }
+  flushBatch();
+}
+
+// Woken by logPrintf through a task notification, one wake drains everything queued since the last one
+void drainTaskMain(void*) {
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    xSemaphoreTake(serialLock, portMAX_DELAY);
+    if (logSerial) {
+      drainRing();
+    }
+    xSemaphoreGive(serialLock);
+  }
+}
+
+// Write a record that found the ring full from the calling task, after everything queued before it
+void writeNow(const Record& record) {
+  // A LogSerialLock holder already owns the port
+  const bool held = xSemaphoreGetMutexHolder(serialLock) == xTaskGetCurrentTaskHandle();
+  if (!held) {
+    xSemaphoreTake(serialLock, portMAX_DELAY);
+  }
+  drainRing();
+  char line[LINE_SIZE];
+  const size_t length = formatRecord(record, line);
+  logSerial.write(reinterpret_cast<const uint8_t*>(line), length);
+  if (!held) {
+    xSemaphoreGive(serialLock);
+  }
+}
+}  // namespace
+
 void logPrintf(const char* level, const char* origin, const char* format, ...) {
   if (!logSerial) {
     return;  // Serial not initialized, skip logging
   }
+
+  uint32_t position;
+  Record* record = ring.claim(position);
+  Record overflow;
+  if (!record) {
+    // Errors are never dropped: with the ring full they are written synchronously instead
+    if (!serialLock || xPortInIsrContext() || strcmp(level, ERR_LEVEL) != 0) {
+      ring.dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    record = &overflow;
+  }
+  record->timestamp = millis();
+  record->level = level;
+  record->origin = origin;
+  record->format = format;
+  record->argLength = 0;
+
   va_list args;
   va_start(args, format);
-  char buf[256];
-  char* c = buf;
-  // add the timestamp
-  {
-    unsigned long ms = millis();
-    int len = snprintf(c, sizeof(buf), "[%lu] ", ms);
-    if (len < 0) {
-      return;  // encoding error, skip logging
-    }
-    c += len;
-  }
-  // add the level
-  {
-    const char* p = level;
-    size_t remaining = sizeof(buf) - (c - buf);
-    while (*p && remaining > 1) {
-      *c++ = *p++;
-      remaining--;
-    }
-    if (remaining > 1) {
-      *c++ = ' ';
-    }
-  }
-  // add the origin
-  {
-    int len = snprintf(c, sizeof(buf) - (c - buf), "[%s] ", origin);
-    if (len < 0) {
-      return;  // encoding error, skip logging
-    }
-    c += len;
-  }
-  // add the user message
-  vsnprintf(c, sizeof(buf) - (c - buf), format, args);
+  ArgWriter writer(*record);
+  bool fits = true;
+  for (const char* p = strchr(format, '%'); p && fits; p = strchr(p, '%')) {
+    const Spec spec = parseSpec(p);
+    for (uint8_t i = 0; i < spec.stars && fits; i++) {
+      fits = writer.put(va_arg(args, int));
+    }
+    switch (spec.type) {
+      case ArgType::NONE:
+        break;
+      case ArgType::INT:
+        fits = fits && writer.put(va_arg(args, int));
+        break;
+      case ArgType::LONG:
+        fits = fits && writer.put(va_arg(args, long));
+        break;
+      case ArgType::LONG_LONG:
+        fits = fits && writer.put(va_arg(args, long long));
+        break;
+      case ArgType::SIZE:
+        fits = fits && writer.put(va_arg(args, size_t));
+        break;
+      case ArgType::DOUBLE:
+        fits = fits && writer.put(va_arg(args, double));
+        break;
+      case ArgType::STRING:
+        fits = fits && writer.putString(va_arg(args, const char*));
+        break;
+      case ArgType::POINTER:
+        fits = fits && writer.put(va_arg(args, const void*));
+        break;
+      default:
+        fits = false;  // Unknown argument size, the rest cannot be read
+        break;
+    }
+    p += spec.length > 0 ? spec.length : 1;
+  }
   va_end(args);
-  logSerial.print(buf);
+
+  if (record == &overflow) {
+    writeNow(overflow);
+    return;
+  }
+  ring.publish(position);
+  if (drainTask) {
+    xTaskNotifyGive(drainTask);
+  }
+}
+
+void logBegin() {
+  if (drainTask) {
+    return;
+  }
+  serialLock = xSemaphoreCreateMutex();
+  if (!serialLock) {
+    return;
+  }
+  // Above idle so a busy loop cannot starve it, and no higher than the loop so logging never preempts the caller
+  xTaskCreate(drainTaskMain, "LogDrain", 4096, nullptr, tskIDLE_PRIORITY + 1, &drainTask);
+}
+
+void logFlush() {
+  if (!serialLock || !logSerial) {
+    return;
+  }
+  xSemaphoreTake(serialLock, portMAX_DELAY);
+  drainRing();
+  logSerial.flush();
+  xSemaphoreGive(serialLock);
+}
+
+uint32_t logDroppedCount() { return ring.dropped.load(std::memory_order_relaxed); }
+
+LogSerialLock::LogSerialLock() {
+  if (serialLock) {
+    xSemaphoreTake(serialLock, portMAX_DELAY);
+    if (logSerial) {
+      drainRing();
+    }
+  }
+}
+
+LogSerialLock::~LogSerialLock() {
+  if (serialLock) {
+    xSemaphoreGive(serialLock);
+  }
 }
+#else
+// The LOG_* macros compile out without ENABLE_SERIAL_LOG, so there is nothing to queue
+void logPrintf(const char*, const char*, const char*, ...) {}
+void logBegin() {}
+void logFlush() {}
+uint32_t logDroppedCount() { return 0; }
+LogSerialLock::LogSerialLock() {}
+LogSerialLock::~LogSerialLock() {}
+#endif
@@ -18,7 +18,17 @@ special formatting), use the underlying logSerial object directly:
     logSerial.write(binaryData, length);
 
 The logSerial reference (defined below) points to the real Serial object and
-won't trigger deprecation warnings.
+won't trigger deprecation warnings. Hold a LogSerialLock while doing so, or log
+lines may land in the middle of the output.
+
+Log calls do not write to serial: they copy the format pointer and arguments
+into a fixed ring, wake the drain task and return. The drain task, started by
+Serial.begin(), formats and writes the records in batches. When the ring is
+full new INF and DBG records are dropped and counted, and the drop count is
+logged once there is room again; ERR records are written synchronously instead.
+Format strings and origins must therefore be literals; %s arguments are copied
+(and may be truncated). Call logFlush() before anything that stops the task,
+such as deep sleep.
 */
 
 #ifndef LOG_LEVEL
@@ -28,6 +38,21 @@ won't trigger deprecation warnings.
 static HWCDC& logSerial = Serial;
 
 void logPrintf(const char* level, const char* origin, const char* format, ...);
+// Start the drain task, safe to call more than once
+void logBegin();
+// Write every queued record from the calling task
+void logFlush();
+// Records dropped because the ring was full, since boot
+uint32_t logDroppedCount();
+
+// Keeps the drain task off the serial port while raw data is written, after flushing queued records
+class LogSerialLock {
+ public:
+  LogSerialLock();
+  ~LogSerialLock();
+  LogSerialLock(const LogSerialLock&) = delete;
+  LogSerialLock& operator=(const LogSerialLock&) = delete;
+};
 
 #ifdef ENABLE_SERIAL_LOG
 #if LOG_LEVEL >= 0
@@ -55,7 +80,10 @@ void logPrintf(const char* level, const char* origin, const char* format, ...);
 
 class MySerialImpl : public Print {
  public:
-  void begin(unsigned long baud) { logSerial.begin(baud); }
+  void begin(unsigned long baud) {
+    logSerial.begin(baud);
+    logBegin();
+  }
 
   // Support boolean conversion for compatibility with code like:
   //   if (Serial) or while (!Serial)
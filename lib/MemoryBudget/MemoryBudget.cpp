@@ -0,0 +1,151 @@
+#include "MemoryBudget.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+
+#include <cstdio>
+
+MemoryBudget MemoryBudget::instance;
+
+namespace {
+// Heap each consumer must leave free after its reservation. Less important consumers leave more, so they are the
+// first to be refused as the heap fills up.
+constexpr size_t HEADROOM_BYTES[] = {
+    8 * 1024,   // FRAMEBUFFER
+    4 * 1024,   // FONT_CACHE
+    32 * 1024,  // CSS
+    16 * 1024,  // IMAGE_DECODE
+    32 * 1024,  // WORD_CACHE
+    64 * 1024,  // PREFETCH
+};
+static_assert(sizeof(HEADROOM_BYTES) / sizeof(HEADROOM_BYTES[0]) ==
+                  static_cast<size_t>(MemoryBudget::Consumer::COUNT),
+              "One headroom per consumer");
+}  // namespace
+
+const char* MemoryBudget::consumerName(const Consumer consumer) {
+  switch (consumer) {
+    case Consumer::FRAMEBUFFER:
+      return "framebuffer";
+    case Consumer::FONT_CACHE:
+      return "font cache";
+    case Consumer::CSS:
+      return "css";
+    case Consumer::IMAGE_DECODE:
+      return "image decode";
+    case Consumer::WORD_CACHE:
+      return "word cache";
+    case Consumer::PREFETCH:
+      return "prefetch";
+    default:
+      return "unknown";
+  }
+}
+
+void MemoryBudget::take() const { xSemaphoreTakeRecursive(lock, portMAX_DELAY); }
+
+void MemoryBudget::give() const { xSemaphoreGiveRecursive(lock); }
+
+bool MemoryBudget::fits(const size_t bytes, const size_t largestBlock, const size_t headroom) {
+  return ESP.getFreeHeap() >= bytes + headroom && ESP.getMaxAllocHeap() >= largestBlock;
+}
+
+bool MemoryBudget::tryReserve(const Consumer consumer, const size_t bytes, const size_t largestBlock) {
+  const auto index = static_cast<size_t>(consumer);
+  if (index >= CONSUMER_COUNT) {
+    return false;
+  }
+  const size_t headroom = HEADROOM_BYTES[index];
+
+  take();
+  // Squeeze less important consumers, least important first, until the reservation fits. Only consumers owned by
+  // this task can be squeezed, others may be using their memory right now.
+  const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  for (size_t victim = CONSUMER_COUNT; victim-- > index + 1 && !fits(bytes, largestBlock, headroom);) {
+    ConsumerState& state = consumers[victim];
+    if (!state.callback || state.reserved == 0 || state.owner != self) {
+      continue;
+    }
+    const size_t before = state.reserved;
+    state.callback(state.context, bytes + headroom);
+    LOG_DBG("MEM", "Pressure from %s: %s shrank from %zu to %zu bytes", consumerName(consumer),
+            consumerName(static_cast<Consumer>(victim)), before, state.reserved);
+  }
+
+  if (!fits(bytes, largestBlock, headroom)) {
+    consumers[index].denied++;
+    LOG_DBG("MEM", "Denied %zu bytes to %s (%u free, %u max block, %zu headroom)", bytes, consumerName(consumer),
+            ESP.getFreeHeap(), ESP.getMaxAllocHeap(), headroom);
+    give();
+    return false;
+  }
+
+  ConsumerState& state = consumers[index];
+  state.reserved += bytes;
+  if (state.reserved > state.peak) {
+    state.peak = state.reserved;
+  }
+  give();
+  return true;
+}
+
+void MemoryBudget::release(const Consumer consumer, const size_t bytes) {
+  const auto index = static_cast<size_t>(consumer);
+  if (index >= CONSUMER_COUNT) {
+    return;
+  }
+  take();
+  ConsumerState& state = consumers[index];
+  if (bytes > state.reserved) {
+    LOG_ERR("MEM", "%s released %zu bytes but only reserved %zu", consumerName(consumer), bytes, state.reserved);
+    state.reserved = 0;
+  } else {
+    state.reserved -= bytes;
+  }
+  give();
+}
+
+void MemoryBudget::setPressureCallback(const Consumer consumer, const PressureCallback callback, void* context) {
+  const auto index = static_cast<size_t>(consumer);
+  if (index >= CONSUMER_COUNT) {
+    return;
+  }
+  take();
+  consumers[index].callback = callback;
+  consumers[index].context = context;
+  consumers[index].owner = callback ? xTaskGetCurrentTaskHandle() : nullptr;
+  give();
+}
+
+size_t MemoryBudget::getReserved(const Consumer consumer) const {
+  const auto index = static_cast<size_t>(consumer);
+  if (index >= CONSUMER_COUNT) {
+    return 0;
+  }
+  take();
+  const size_t reserved = consumers[index].reserved;
+  give();
+  return reserved;
+}
+
+void MemoryBudget::logUsage() const {
+  // One line: "name reserved/peak" per consumer, with denials when there were any
+  char line[256];
+  size_t length = 0;
+  take();
+  for (size_t i = 0; i < CONSUMER_COUNT && length < sizeof(line); i++) {
+    const ConsumerState& state = consumers[i];
+    const int written =
+        state.denied > 0
+            ? snprintf(line + length, sizeof(line) - length, "%s%s %zu/%zu (%u denied)", i > 0 ? ", " : "",
+                       consumerName(static_cast<Consumer>(i)), state.reserved, state.peak, state.denied)
+            : snprintf(line + length, sizeof(line) - length, "%s%s %zu/%zu", i > 0 ? ", " : "",
+                       consumerName(static_cast<Consumer>(i)), state.reserved, state.peak);
+    if (written < 0) {
+      break;
+    }
+    length += static_cast<size_t>(written);
+  }
+  give();
+  LOG_INF("MEM", "Budget (reserved/peak bytes): %s", line);
+}
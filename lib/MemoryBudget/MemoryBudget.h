@@ -0,0 +1,90 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Central heap budget for large, optional allocations.
+ *
+ * Consumers reserve bytes under their name before allocating and release them after freeing. A reservation is
+ * granted when the heap keeps the consumer's headroom afterwards and the largest free block fits the biggest single
+ * allocation. Otherwise lower-priority consumers are asked, lowest first, to shrink through their pressure callback
+ * before the reservation is denied, so caches give memory back instead of features silently degrading.
+ *
+ * A pressure callback only runs for reservations made on the task that registered it, so a consumer's memory is never
+ * freed while another task is using it. Register from the task that owns the memory; reservations from other tasks
+ * skip that consumer.
+ *
+ * The budget does not allocate anything itself: it serializes the decisions and keeps per-consumer accounting,
+ * which logUsage prints.
+ */
+class MemoryBudget {
+ public:
+  // In priority order, most important first
+  enum class Consumer : uint8_t { FRAMEBUFFER, FONT_CACHE, CSS, IMAGE_DECODE, WORD_CACHE, PREFETCH, COUNT };
+
+  // Asked to free about bytesWanted. Consumers release what they freed before returning.
+  using PressureCallback = void (*)(void* context, size_t bytesWanted);
+
+  // Reserve bytes, allocated in blocks of at most largestBlock (pass bytes for a single allocation)
+  bool tryReserve(Consumer consumer, size_t bytes, size_t largestBlock);
+  bool tryReserve(const Consumer consumer, const size_t bytes) { return tryReserve(consumer, bytes, bytes); }
+  void release(Consumer consumer, size_t bytes);
+
+  // One callback per consumer, owned by the calling task; pass nullptr to unregister
+  void setPressureCallback(Consumer consumer, PressureCallback callback, void* context);
+
+  size_t getReserved(Consumer consumer) const;
+  void logUsage() const;
+
+  static const char* consumerName(Consumer consumer);
+  static MemoryBudget& getInstance() { return instance; }
+
+ private:
+  static constexpr size_t CONSUMER_COUNT = static_cast<size_t>(Consumer::COUNT);
+
+  struct ConsumerState {
+    size_t reserved = 0;
+    size_t peak = 0;
+    uint32_t denied = 0;
+    PressureCallback callback = nullptr;
+    void* context = nullptr;
+    TaskHandle_t owner = nullptr;  // Task that registered the callback, the only one it runs on
+  };
+
+  static MemoryBudget instance;
+
+  ConsumerState consumers[CONSUMER_COUNT];
+  SemaphoreHandle_t lock;  // Recursive, pressure callbacks release while a reservation is pending
+
+  MemoryBudget() : lock(xSemaphoreCreateRecursiveMutex()) {}
+  void take() const;
+  void give() const;
+  static bool fits(size_t bytes, size_t largestBlock, size_t headroom);
+};
+
+#define MemBudget MemoryBudget::getInstance()
+
+// Holds a reservation for the lifetime of a scope, e.g. while a decoder object is alive
+class ScopedReservation {
+ public:
+  ScopedReservation(const MemoryBudget::Consumer consumer, const size_t bytes)
+      : consumer(consumer), bytes(MemBudget.tryReserve(consumer, bytes) ? bytes : 0) {}
+  ~ScopedReservation() {
+    if (bytes > 0) {
+      MemBudget.release(consumer, bytes);
+    }
+  }
+  ScopedReservation(const ScopedReservation&) = delete;
+  ScopedReservation& operator=(const ScopedReservation&) = delete;
+
+  explicit operator bool() const { return bytes > 0; }
+
+ private:
+  MemoryBudget::Consumer consumer;
+  size_t bytes;
+};
@@ -0,0 +1,131 @@
+#include "PerfTrace.h"
+
+namespace perf {
+
+const char* metricName(const Metric metric) {
+  switch (metric) {
+    case Metric::SECTION_BUILD:
+      return "section_build";
+    case Metric::PAGE_LOAD:
+      return "page_load";
+    case Metric::RENDER_BW:
+      return "render_bw";
+    case Metric::RENDER_GRAYSCALE:
+      return "render_grayscale";
+    case Metric::DISPLAY_REFRESH:
+      return "display_refresh";
+    case Metric::DISPLAY_TRANSFER:
+      return "display_transfer";
+    case Metric::ZIP_INFLATE:
+      return "zip_inflate";
+    case Metric::SD_READ:
+      return "sd_read";
+    default:
+      return "unknown";
+  }
+}
+
+const char* counterName(const Counter counter) {
+  switch (counter) {
+    case Counter::SECTION_PAGES:
+      return "section_pages";
+    case Counter::ZIP_INFLATED_BYTES:
+      return "zip_inflated_bytes";
+    case Counter::SD_READ_BYTES:
+      return "sd_read_bytes";
+    default:
+      return "unknown";
+  }
+}
+
+#ifdef ENABLE_PERF_TRACE
+namespace {
+constexpr size_t METRIC_COUNT = static_cast<size_t>(Metric::COUNT);
+constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::COUNT);
+// Samples kept per metric for min/avg/max, must be a power of two
+constexpr size_t RING_SIZE = 32;
+static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be a power of two");
+
+struct MetricRing {
+  uint32_t samples[RING_SIZE];
+  uint32_t count;
+};
+
+MetricRing rings[METRIC_COUNT] = {};
+uint32_t counters[COUNTER_COUNT] = {};
+}  // namespace
+
+void record(const Metric metric, const uint32_t micros) {
+  const auto index = static_cast<size_t>(metric);
+  if (index >= METRIC_COUNT) {
+    return;
+  }
+  MetricRing& ring = rings[index];
+  // Masking keeps a racing writer inside the ring
+  ring.samples[ring.count & (RING_SIZE - 1)] = micros;
+  ring.count++;
+}
+
+void count(const Counter counter, const uint32_t amount) {
+  const auto index = static_cast<size_t>(counter);
+  if (index < COUNTER_COUNT) {
+    counters[index] += amount;
+  }
+}
+
+Stats getStats(const Metric metric) {
+  Stats stats;
+  const auto index = static_cast<size_t>(metric);
+  if (index >= METRIC_COUNT || rings[index].count == 0) {
+    return stats;
+  }
+
+  const MetricRing& ring = rings[index];
+  stats.count = ring.count;
+  const size_t filled = ring.count < RING_SIZE ? ring.count : RING_SIZE;
+  uint64_t total = 0;
+  stats.minMicros = UINT32_MAX;
+  for (size_t i = 0; i < filled; i++) {
+    const uint32_t sample = ring.samples[i];
+    total += sample;
+    stats.minMicros = sample < stats.minMicros ? sample : stats.minMicros;
+    stats.maxMicros = sample > stats.maxMicros ? sample : stats.maxMicros;
+  }
+  stats.avgMicros = static_cast<uint32_t>(total / filled);
+  return stats;
+}
+
+uint32_t getCounter(const Counter counter) {
+  const auto index = static_cast<size_t>(counter);
+  return index < COUNTER_COUNT ? counters[index] : 0;
+}
+
+void reset() {
+  for (auto& ring : rings) {
+    ring.count = 0;
+  }
+  for (auto& counter : counters) {
+    counter = 0;
+  }
+}
+#endif
+
+void printStats(Print& out) {
+  out.printf("STATS_START\n");
+  if (!enabled) {
+    out.printf("disabled\n");
+  }
+  for (size_t i = 0; enabled && i < static_cast<size_t>(Metric::COUNT); i++) {
+    const auto metric = static_cast<Metric>(i);
+    const Stats stats = getStats(metric);
+    out.printf("%s count=%lu min=%luus avg=%luus max=%luus\n", metricName(metric), stats.count, stats.minMicros,
+               stats.avgMicros, stats.maxMicros);
+  }
+  for (size_t i = 0; enabled && i < static_cast<size_t>(Counter::COUNT); i++) {
+    const auto counter = static_cast<Counter>(i);
+    out.printf("%s %lu\n", counterName(counter), getCounter(counter));
+  }
+  out.printf("STATS_END\n");
+}
+
+}  // namespace perf
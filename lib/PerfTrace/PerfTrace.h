@@ -0,0 +1,123 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstdint>
+
+/*
+Lightweight performance tracing: timing metrics with min/avg/max over the most recent samples, and monotonic
+counters. Storage is fixed and static, nothing is allocated.
+
+Tracing is compiled in with serial logging (ENABLE_SERIAL_LOG), so slim builds compile every probe down to nothing.
+Probes are not synchronized; a sample recorded concurrently from another task may be lost, which is fine for
+statistics.
+
+    {
+      perf::Scope scope(perf::Metric::PAGE_LOAD);
+      ...  // timed until the end of the block
+    }
+    perf::count(perf::Counter::SD_READ_BYTES, bytesRead);
+*/
+
+#ifdef ENABLE_SERIAL_LOG
+#define ENABLE_PERF_TRACE
+#endif
+
+namespace perf {
+
+enum class Metric : uint8_t {
+  SECTION_BUILD,
+  PAGE_LOAD,
+  RENDER_BW,
+  RENDER_GRAYSCALE,
+  DISPLAY_REFRESH,
+  DISPLAY_TRANSFER,
+  ZIP_INFLATE,
+  SD_READ,
+  COUNT
+};
+
+enum class Counter : uint8_t { SECTION_PAGES, ZIP_INFLATED_BYTES, SD_READ_BYTES, COUNT };
+
+struct Stats {
+  uint32_t count = 0;  // Samples since boot
+  uint32_t minMicros = 0;  // Over the most recent samples
+  uint32_t avgMicros = 0;
+  uint32_t maxMicros = 0;
+};
+
+const char* metricName(Metric metric);
+const char* counterName(Counter counter);
+
+#ifdef ENABLE_PERF_TRACE
+constexpr bool enabled = true;
+
+void record(Metric metric, uint32_t micros);
+void count(Counter counter, uint32_t amount = 1);
+Stats getStats(Metric metric);
+uint32_t getCounter(Counter counter);
+void reset();
+
+// Times the enclosing scope as one sample
+class Scope {
+ public:
+  explicit Scope(const Metric metric) : metric(metric), start(micros()) {}
+  ~Scope() { record(metric, micros() - start); }
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+ private:
+  Metric metric;
+  uint32_t start;
+};
+
+// Sums several timed sections (e.g. every read of a streamed file) into one sample, recorded on destruction
+class Accumulator {
+ public:
+  explicit Accumulator(const Metric metric) : metric(metric) {}
+  ~Accumulator() {
+    if (used) {
+      record(metric, total);
+    }
+  }
+  Accumulator(const Accumulator&) = delete;
+  Accumulator& operator=(const Accumulator&) = delete;
+
+  void begin() { start = micros(); }
+  void end() {
+    total += micros() - start;
+    used = true;
+  }
+
+ private:
+  Metric metric;
+  uint32_t start = 0;
+  uint32_t total = 0;
+  bool used = false;
+};
+#else
+constexpr bool enabled = false;
+
+inline void record(Metric, uint32_t) {}
+inline void count(Counter, uint32_t = 1) {}
+inline Stats getStats(Metric) { return {}; }
+inline uint32_t getCounter(Counter) { return 0; }
+inline void reset() {}
+
+class Scope {
+ public:
+  explicit Scope(Metric) {}
+};
+
+class Accumulator {
+ public:
+  explicit Accumulator(Metric) {}
+  void begin() {}
+  void end() {}
+};
+#endif
+
+// Write all metrics and counters as STATS_START ... STATS_END lines
+void printStats(Print& out);
+
+}  // namespace perf
@@ -30,6 +30,17 @@ uint32_t utf8NextCodepoint(const unsigned char** string) {
   return cp;
 }
 
+uint32_t utf8NextCodepoint(const unsigned char** string, const unsigned char* end) {
+  if (*string >= end || **string == 0) {
+    return 0;
+  }
+  if (utf8CodepointLen(**string) > end - *string) {
+    *string = end;
+    return REPLACEMENT_GLYPH;
+  }
+  return utf8NextCodepoint(string);
+}
+
 size_t utf8RemoveLastChar(std::string& str) {
   if (str.empty()) return 0;
   size_t pos = str.size() - 1;
@@ -1,10 +1,34 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <vector>
 #define REPLACEMENT_GLYPH 0xFFFD
 
 uint32_t utf8NextCodepoint(const unsigned char** string);
+// Same, but never reads at or past end: a sequence cut short by end (words are split at a byte limit) decodes as
+// REPLACEMENT_GLYPH and leaves *string at end. Returns 0 once *string reaches end.
+uint32_t utf8NextCodepoint(const unsigned char** string, const unsigned char* end);
+// Cumulative advances of text at every byte offset: prefixAdvances[i] is the advance of text[0, i) at codepoint
+// boundaries, and bytes inside a sequence hold the advance before it. advanceOf(cp) gives one codepoint's advance.
+template <typename AdvanceFn>
+void utf8PrefixAdvances(const std::string& text, AdvanceFn&& advanceOf, std::vector<uint16_t>& prefixAdvances) {
+  prefixAdvances.assign(text.size() + 1, 0);
+  const auto* start = reinterpret_cast<const unsigned char*>(text.data());
+  const unsigned char* end = start + text.size();
+  const unsigned char* next = start;
+  size_t offset = 0;
+  int width = 0;
+  uint32_t cp;
+  while ((cp = utf8NextCodepoint(&next, end))) {
+    const size_t nextOffset = next - start;
+    std::fill(prefixAdvances.begin() + offset + 1, prefixAdvances.begin() + nextOffset, width);
+    width += advanceOf(cp);
+    prefixAdvances[nextOffset] = static_cast<uint16_t>(width);
+    offset = nextOffset;
+  }
+}
 // Remove the last UTF-8 codepoint from a std::string and return the new size.
 size_t utf8RemoveLastChar(std::string& str);
 // Truncate string by removing N UTF-8 codepoints from the end.
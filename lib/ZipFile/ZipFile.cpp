@@ -2,10 +2,19 @@
 
 #include <HalStorage.h>
 #include <Logging.h>
+#include <PerfTrace.h>
 #include <miniz.h>
 
 #include <algorithm>
 
+// Bulk data reads, traced as SD reads
+static size_t timedRead(FsFile& file, void* buffer, const size_t length) {
+  perf::Scope perfScope(perf::Metric::SD_READ);
+  const size_t read = file.read(buffer, length);
+  perf::count(perf::Counter::SD_READ_BYTES, read);
+  return read;
+}
+
 static bool inflateOneShot(const uint8_t* inputBuf, const size_t deflatedSize, uint8_t* outputBuf,
                            const size_t inflatedSize) {
   const auto inflator = static_cast<tinfl_decompressor*>(malloc(sizeof(tinfl_decompressor)));
@@ -16,6 +25,7 @@ static bool inflateOneShot(const uint8_t* inputBuf, const size_t deflatedSize, u
   memset(inflator, 0, sizeof(tinfl_decompressor));
   tinfl_init(inflator);
 
+  perf::Scope perfScope(perf::Metric::ZIP_INFLATE);
   size_t inBytes = deflatedSize;
   size_t outBytes = inflatedSize;
   const tinfl_status status = tinfl_decompress(inflator, inputBuf, &inBytes, nullptr, outputBuf, &outBytes,
@@ -28,6 +38,7 @@ static bool inflateOneShot(const uint8_t* inputBuf, const size_t deflatedSize, u
     return false;
   }
 
+  perf::count(perf::Counter::ZIP_INFLATED_BYTES, outBytes);
   return true;
 }
 
@@ -417,7 +428,7 @@ uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const boo
 
   if (fileStat.method == MZ_NO_COMPRESSION) {
     // no deflation, just read content
-    const size_t dataRead = file.read(data, inflatedDataSize);
+    const size_t dataRead = timedRead(file, data, inflatedDataSize);
     if (!wasOpen) {
       close();
     }
@@ -440,7 +451,7 @@ uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const boo
       return nullptr;
     }
 
-    const size_t dataRead = file.read(deflatedData, deflatedDataSize);
+    const size_t dataRead = timedRead(file, deflatedData, deflatedDataSize);
     if (!wasOpen) {
       close();
     }
@@ -508,7 +519,7 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
 
     size_t remaining = inflatedDataSize;
     while (remaining > 0) {
-      const size_t dataRead = file.read(buffer, remaining < chunkSize ? remaining : chunkSize);
+      const size_t dataRead = timedRead(file, buffer, remaining < chunkSize ? remaining : chunkSize);
       if (dataRead == 0) {
         LOG_ERR("ZIP", "Could not read more bytes");
         free(buffer);
@@ -569,6 +580,7 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
     size_t fileReadBufferFilledBytes = 0;
     size_t fileReadBufferCursor = 0;
     size_t outputCursor = 0;  // Current offset in the circular dictionary
+    perf::Accumulator inflateTime(perf::Metric::ZIP_INFLATE);
 
     while (true) {
       // Load more compressed bytes when needed
@@ -579,7 +591,7 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
         }
 
         fileReadBufferFilledBytes =
-            file.read(fileReadBuffer, fileRemainingBytes < chunkSize ? fileRemainingBytes : chunkSize);
+            timedRead(file, fileReadBuffer, fileRemainingBytes < chunkSize ? fileRemainingBytes : chunkSize);
         fileRemainingBytes -= fileReadBufferFilledBytes;
         fileReadBufferCursor = 0;
 
@@ -594,9 +606,11 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
       // Space remaining in outputBuffer
       size_t outBytes = TINFL_LZ_DICT_SIZE - outputCursor;
 
+      inflateTime.begin();
       const tinfl_status status = tinfl_decompress(inflator, fileReadBuffer + fileReadBufferCursor, &inBytes,
                                                    outputBuffer, outputBuffer + outputCursor, &outBytes,
                                                    fileRemainingBytes > 0 ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+      inflateTime.end();
 
       // Update input position
       fileReadBufferCursor += inBytes;
@@ -604,6 +618,7 @@ bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t ch
       // Write output chunk
       if (outBytes > 0) {
         processedOutputBytes += outBytes;
+        perf::count(perf::Counter::ZIP_INFLATED_BYTES, outBytes);
         if (out.write(outputBuffer + outputCursor, outBytes) != outBytes) {
           LOG_ERR("ZIP", "Failed to write all output bytes to stream");
           if (!wasOpen) {
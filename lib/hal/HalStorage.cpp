@@ -1,5 +1,6 @@
 #include "HalStorage.h"
 
+#include <PerfTrace.h>
 #include <SDCardManager.h>
 
 #define SDCard SDCardManager::getInstance()
@@ -17,11 +18,15 @@ std::vector<String> HalStorage::listFiles(const char* path, int maxFiles) { retu
 String HalStorage::readFile(const char* path) { return SDCard.readFile(path); }
 
 bool HalStorage::readFileToStream(const char* path, Print& out, size_t chunkSize) {
+  perf::Scope perfScope(perf::Metric::SD_READ);
   return SDCard.readFileToStream(path, out, chunkSize);
 }
 
 size_t HalStorage::readFileToBuffer(const char* path, char* buffer, size_t bufferSize, size_t maxBytes) {
-  return SDCard.readFileToBuffer(path, buffer, bufferSize, maxBytes);
+  perf::Scope perfScope(perf::Metric::SD_READ);
+  const size_t read = SDCard.readFileToBuffer(path, buffer, bufferSize, maxBytes);
+  perf::count(perf::Counter::SD_READ_BYTES, read);
+  return read;
 }
 
 bool HalStorage::writeFile(const char* path, const String& content) { return SDCard.writeFile(path, content); }
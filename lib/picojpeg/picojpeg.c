@@ -222,7 +222,7 @@ static uint8 gMCUOrg[6];
 static pjpeg_need_bytes_callback_t g_pNeedBytesCallback;
 static void* g_pCallback_data;
 static uint8 gCallbackStatus;
-static uint8 gReduce;
+static uint8 gBlockSize;  // Output pixels per block side: 8, 4 (1/2), 2 (1/4) or 1 (1/8)
 //------------------------------------------------------------------------------
 static void fillInBuf(void) {
   unsigned char status;
@@ -581,7 +581,8 @@ static uint8 readDQTMarker(void) {
         gQuant0[i] = (int16)temp;
     }
 
-    createWinogradQuant(n ? gQuant1 : gQuant0);
+    // Scaled decoding runs its own IDCT on raw coefficients
+    if ((gBlockSize == 8) || (gBlockSize == 1)) createWinogradQuant(n ? gQuant1 : gQuant0);
 
     totalRead = 64 + 1;
 
@@ -1725,6 +1726,122 @@ static void transformBlock(uint8 mcuBlock) {
   }
 }
 //------------------------------------------------------------------------------
+// Scaled IDCT for 1/2 and 1/4 decoding. The low frequency 4x4 or 2x2 coefficients are evaluated at the centre of each
+// 2x2 or 4x4 group of full resolution pixels, which is a 4 or 2 point IDCT with the 8 point normalization. Works on
+// raw (not Winograd scaled) coefficients and leaves the pixels in the top left of gCoeffBuf, with a row stride of 8.
+
+#define PJPG_SCALED_FIX_BITS 12
+#define PJPG_SCALED_ROW_BITS 10
+
+// 4096 * (1/(2*sqrt(2))), 4096 * cos(pi/8)/2, 4096 * cos(3*pi/8)/2
+#define PJPG_SCALED_K0 1448L
+#define PJPG_SCALED_K1 1892L
+#define PJPG_SCALED_K3 784L
+
+static void idctScaled(void) {
+  uint8 i;
+  int16* pSrc = gCoeffBuf;
+
+  if (gBlockSize == 2) {
+    long a = pSrc[0], b = pSrc[1], c = pSrc[8], d = pSrc[9];
+
+    // Each pixel is (F00 +/- F01 +/- F10 +/- F11) / 8
+    pSrc[0] = clamp((int16)(((a + b + c + d + 4) >> 3) + 128));
+    pSrc[1] = clamp((int16)(((a - b + c - d + 4) >> 3) + 128));
+    pSrc[8] = clamp((int16)(((a + b - c - d + 4) >> 3) + 128));
+    pSrc[9] = clamp((int16)(((a - b - c + d + 4) >> 3) + 128));
+    return;
+  }
+
+  {
+    long tmp[16];
+
+    for (i = 0; i < 4; i++, pSrc += 8) {
+      long e0 = ((long)pSrc[0] + pSrc[2]) * PJPG_SCALED_K0;
+      long e1 = ((long)pSrc[0] - pSrc[2]) * PJPG_SCALED_K0;
+      long o0 = pSrc[1] * PJPG_SCALED_K1 + pSrc[3] * PJPG_SCALED_K3;
+      long o1 = pSrc[1] * PJPG_SCALED_K3 - pSrc[3] * PJPG_SCALED_K1;
+
+      tmp[i * 4 + 0] = (e0 + o0) >> PJPG_SCALED_ROW_BITS;
+      tmp[i * 4 + 1] = (e1 + o1) >> PJPG_SCALED_ROW_BITS;
+      tmp[i * 4 + 2] = (e1 - o1) >> PJPG_SCALED_ROW_BITS;
+      tmp[i * 4 + 3] = (e0 - o0) >> PJPG_SCALED_ROW_BITS;
+    }
+
+    for (i = 0; i < 4; i++) {
+      const uint8 shift = 2 * PJPG_SCALED_FIX_BITS - PJPG_SCALED_ROW_BITS;
+      const long round = 1L << (shift - 1);
+      long e0 = (tmp[i] + tmp[8 + i]) * PJPG_SCALED_K0;
+      long e1 = (tmp[i] - tmp[8 + i]) * PJPG_SCALED_K0;
+      long o0 = tmp[4 + i] * PJPG_SCALED_K1 + tmp[12 + i] * PJPG_SCALED_K3;
+      long o1 = tmp[4 + i] * PJPG_SCALED_K3 - tmp[12 + i] * PJPG_SCALED_K1;
+
+      gCoeffBuf[0 * 8 + i] = clamp((int16)(((e0 + o0 + round) >> shift) + 128));
+      gCoeffBuf[1 * 8 + i] = clamp((int16)(((e1 + o1 + round) >> shift) + 128));
+      gCoeffBuf[2 * 8 + i] = clamp((int16)(((e1 - o1 + round) >> shift) + 128));
+      gCoeffBuf[3 * 8 + i] = clamp((int16)(((e0 - o0 + round) >> shift) + 128));
+    }
+  }
+}
+//------------------------------------------------------------------------------
+// Y block of a scaled MCU to RGB
+static void copyYScaled(uint8 dstOfs) {
+  uint8 x, y;
+
+  for (y = 0; y < gBlockSize; y++) {
+    for (x = 0; x < gBlockSize; x++) {
+      uint8 ofs = (uint8)(dstOfs + y * 8 + x);
+      uint8 c = (uint8)gCoeffBuf[y * 8 + x];
+
+      gMCUBufR[ofs] = c;
+      gMCUBufG[ofs] = c;
+      gMCUBufB[ofs] = c;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+// Cb or Cr block of a scaled MCU, upsampled over the Y blocks it covers, convert to RGB and accumulate
+static void convertChromaScaled(uint8 isCr) {
+  uint8 hShift = (gScanType == PJPG_YH2V1) || (gScanType == PJPG_YH2V2);
+  uint8 vShift = (gScanType == PJPG_YH1V2) || (gScanType == PJPG_YH2V2);
+  uint8 bx, by, x, y;
+
+  for (by = 0; by <= vShift; by++) {
+    for (bx = 0; bx <= hShift; bx++) {
+      for (y = 0; y < gBlockSize; y++) {
+        for (x = 0; x < gBlockSize; x++) {
+          uint8 ofs = (uint8)(by * 128 + bx * 64 + y * 8 + x);
+          uint8 c = (uint8)gCoeffBuf[((by * gBlockSize + y) >> vShift) * 8 + ((bx * gBlockSize + x) >> hShift)];
+
+          if (isCr) {
+            int16 crR = (c + ((c * 103U) >> 8U)) - 179;
+            int16 crG = ((c * 183U) >> 8U) - 91;
+            gMCUBufR[ofs] = addAndClamp(gMCUBufR[ofs], crR);
+            gMCUBufG[ofs] = subAndClamp(gMCUBufG[ofs], crG);
+          } else {
+            int16 cbG = ((c * 88U) >> 8U) - 44U;
+            int16 cbB = (c + ((c * 198U) >> 8U)) - 227U;
+            gMCUBufG[ofs] = subAndClamp(gMCUBufG[ofs], cbG);
+            gMCUBufB[ofs] = addAndClamp(gMCUBufB[ofs], cbB);
+          }
+        }
+      }
+    }
+  }
+}
+//------------------------------------------------------------------------------
+static void transformBlockScaled(uint8 mcuBlock) {
+  // Y blocks come first, then Cb and Cr
+  uint8 numYBlocks = (gScanType == PJPG_GRAYSCALE) ? 1 : (uint8)(gMaxBlocksPerMCU - 2);
+
+  idctScaled();
+
+  if (mcuBlock < numYBlocks)
+    copyYScaled((uint8)((gScanType == PJPG_YH1V2) ? mcuBlock * 128 : mcuBlock * 64));
+  else
+    convertChromaScaled(mcuBlock == numYBlocks + 1);
+}
+//------------------------------------------------------------------------------
 static void transformBlockReduce(uint8 mcuBlock) {
   uint8 c = clamp(PJPG_DESCALE(gCoeffBuf[0]) + 128);
   int16 cbG, cbB, crR, crG;
@@ -1941,7 +2058,7 @@ static uint8 decodeNextMCU(void) {
 
     compACTab = gCompACTab[componentID];
 
-    if (gReduce) {
+    if (gBlockSize == 1) {
       // Decode, but throw out the AC coefficients in reduce mode.
       for (k = 1; k < 64; k++) {
         s = huffDecode(compACTab ? &gHuffTab3 : &gHuffTab2, compACTab ? gHuffVal3 : gHuffVal2);
@@ -1969,6 +2086,48 @@ static uint8 decodeNextMCU(void) {
       }
 
       transformBlockReduce(mcuBlock);
+    } else if (gBlockSize < 8) {
+      // Scaled mode: only dequantize the coefficients the scaled IDCT uses
+      int16 dcCoeff = gCoeffBuf[0];
+
+      for (k = 0; k < 64; k++)
+        if (((k & 7) < gBlockSize) && ((k >> 3) < gBlockSize)) gCoeffBuf[k] = 0;
+      gCoeffBuf[0] = dcCoeff;
+
+      for (k = 1; k < 64; k++) {
+        uint16 extraBits;
+
+        s = huffDecode(compACTab ? &gHuffTab3 : &gHuffTab2, compACTab ? gHuffVal3 : gHuffVal2);
+
+        extraBits = 0;
+        numExtraBits = s & 0xF;
+        if (numExtraBits) extraBits = getBits2(numExtraBits);
+
+        r = s >> 4;
+        s &= 15;
+
+        if (s) {
+          uint8 z;
+
+          if (r) {
+            if ((k + r) > 63) return PJPG_DECODE_ERROR;
+
+            k = (uint8)(k + r);
+          }
+
+          z = (uint8)ZAG[k];
+          if (((z & 7) < gBlockSize) && ((z >> 3) < gBlockSize)) gCoeffBuf[z] = huffExtend(extraBits, s) * pQ[k];
+        } else {
+          if (r == 15) {
+            if ((k + 16) > 64) return PJPG_DECODE_ERROR;
+
+            k += (16 - 1);  // - 1 because the loop counter is k
+          } else
+            break;
+        }
+      }
+
+      transformBlockScaled(mcuBlock);
     } else {
       // Decode and dequantize AC coefficients
       for (k = 1; k < 64; k++) {
@@ -2057,7 +2216,20 @@ unsigned char pjpeg_decode_init(pjpeg_image_info_t* pInfo, pjpeg_need_bytes_call
   g_pNeedBytesCallback = pNeed_bytes_callback;
   g_pCallback_data = pCallback_data;
   gCallbackStatus = 0;
-  gReduce = reduce;
+  switch (reduce) {
+    case PJPG_SCALE_1_8:
+      gBlockSize = 1;
+      break;
+    case PJPG_SCALE_1_4:
+      gBlockSize = 2;
+      break;
+    case PJPG_SCALE_1_2:
+      gBlockSize = 4;
+      break;
+    default:
+      gBlockSize = 8;
+      break;
+  }
 
   status = init();
   if ((status) || (gCallbackStatus)) return gCallbackStatus ? gCallbackStatus : status;
@@ -49,6 +49,9 @@ enum {
   PJPG_UNSUPPORTED_MODE,  // picojpeg doesn't support progressive JPEG's
 };
 
+// Values for pjpeg_decode_init's reduce parameter
+enum { PJPG_SCALE_FULL = 0, PJPG_SCALE_1_8 = 1, PJPG_SCALE_1_4 = 2, PJPG_SCALE_1_2 = 3 };
+
 // Scan types
 typedef enum { PJPG_GRAYSCALE, PJPG_YH1V1, PJPG_YH2V1, PJPG_YH1V2, PJPG_YH2V2 } pjpeg_scan_type_t;
 
@@ -107,8 +110,10 @@ typedef unsigned char (*pjpeg_need_bytes_callback_t)(unsigned char* pBuf, unsign
 
 // Initializes the decompressor. Returns 0 on success, or one of the above error codes on failure.
 // pNeed_bytes_callback will be called to fill the decompressor's internal input buffer.
-// If reduce is 1, only the first pixel of each block will be decoded. This mode is much faster because it skips the AC
-// dequantization, IDCT and chroma upsampling of every image pixel. Not thread safe.
+// If reduce is 1 (PJPG_SCALE_1_8), only the first pixel of each block will be decoded. This mode is much faster because
+// it skips the AC dequantization, IDCT and chroma upsampling of every image pixel. PJPG_SCALE_1_4 and PJPG_SCALE_1_2
+// only dequantize the 2x2 or 4x4 lowest frequency coefficients and run a scaled IDCT, leaving the top left 2x2 or 4x4
+// pixels of each 8x8 block valid. MCU sizes and block offsets stay those of the full resolution image. Not thread safe.
 unsigned char pjpeg_decode_init(pjpeg_image_info_t* pInfo, pjpeg_need_bytes_callback_t pNeed_bytes_callback,
                                 void* pCallback_data, unsigned char reduce);
 
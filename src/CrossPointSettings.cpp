@@ -135,6 +135,7 @@ uint8_t CrossPointSettings::writeSettings(FsFile& file, bool count_only) const {
   writer.writeItem(file, fadingFix);
   writer.writeItem(file, embeddedStyle);
   writer.writeItem(file, timezoneOffsetHours);
+  writer.writeItem(file, prerenderImages);
   // New fields need to be added at end for backward compatibility
 
   return writer.item_count;
@@ -264,6 +265,8 @@ bool CrossPointSettings::loadFromFile() {
     if (++settingsRead >= fileSettingsCount) break;
     serialization::readPod(inputFile, timezoneOffsetHours);
     if (++settingsRead >= fileSettingsCount) break;
+    serialization::readPod(inputFile, prerenderImages);
+    if (++settingsRead >= fileSettingsCount) break;
     // New fields added at end for backward compatibility
   } while (false);
 
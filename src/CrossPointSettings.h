@@ -178,6 +178,8 @@ class CrossPointSettings {
   uint8_t embeddedStyle = 1;
   // Timezone Offset (-12 to +14 hours)
   int8_t timezoneOffsetHours = 0;
+  // Decode inline images while indexing a chapter instead of on the first page turn to them
+  uint8_t prerenderImages = 0;
 
   ~CrossPointSettings() = default;
 
@@ -0,0 +1,222 @@
+#include "ResumeSnapshot.h"
+
+#include <GfxRenderer.h>
+#include <HalStorage.h>
+#include <Logging.h>
+#include <Serialization.h>
+
+#include <cstring>
+
+namespace {
+constexpr uint8_t SNAPSHOT_FILE_VERSION = 1;
+constexpr char SNAPSHOT_FILE[] = "/.crosspoint/resume.bin";
+constexpr size_t IO_BUFFER_SIZE = 512;
+constexpr size_t MAX_RUN = 128;  // PackBits runs and literals are 1-128 bytes
+
+// PackBits: a header n < 128 is followed by n + 1 literal bytes, n > 128 by one byte repeated 257 - n times. Pages
+// are mostly white, so this shrinks the 48KB framebuffer to a few KB without a compressor's working memory.
+class PackBitsWriter {
+ public:
+  explicit PackBitsWriter(FsFile& file) : file(file) {}
+
+  bool write(const uint8_t* data, const size_t size) {
+    size_t i = 0;
+    while (i < size) {
+      size_t run = 1;
+      while (i + run < size && run < MAX_RUN && data[i + run] == data[i]) run++;
+      if (run >= 3) {
+        put(static_cast<uint8_t>(257 - run));
+        put(data[i]);
+        i += run;
+        continue;
+      }
+      // Literals until the next run of three
+      size_t literal = 0;
+      while (i + literal < size && literal < MAX_RUN &&
+             !(i + literal + 2 < size && data[i + literal] == data[i + literal + 1] &&
+               data[i + literal] == data[i + literal + 2])) {
+        literal++;
+      }
+      put(static_cast<uint8_t>(literal - 1));
+      for (size_t j = 0; j < literal; j++) put(data[i + j]);
+      i += literal;
+    }
+    flush();
+    return ok;
+  }
+
+  uint32_t written() const { return total; }
+
+ private:
+  FsFile& file;
+  uint8_t buffer[IO_BUFFER_SIZE];
+  size_t length = 0;
+  uint32_t total = 0;
+  bool ok = true;
+
+  void put(const uint8_t byte) {
+    if (length == sizeof(buffer)) flush();
+    buffer[length++] = byte;
+  }
+
+  void flush() {
+    if (length > 0 && file.write(buffer, length) != length) ok = false;
+    total += length;
+    length = 0;
+  }
+};
+
+class PackBitsReader {
+ public:
+  PackBitsReader(FsFile& file, const uint32_t size) : file(file), remaining(size) {}
+
+  bool read(uint8_t* out, const size_t size) {
+    size_t filled = 0;
+    while (filled < size) {
+      int header;
+      if (!get(header)) return false;
+      if (header < 128) {
+        const size_t count = header + 1;
+        if (filled + count > size) return false;
+        for (size_t j = 0; j < count; j++) {
+          int byte;
+          if (!get(byte)) return false;
+          out[filled++] = byte;
+        }
+      } else if (header > 128) {
+        const size_t count = 257 - header;
+        int byte;
+        if (filled + count > size || !get(byte)) return false;
+        memset(out + filled, byte, count);
+        filled += count;
+      }
+    }
+    return true;
+  }
+
+ private:
+  FsFile& file;
+  uint32_t remaining;
+  uint8_t buffer[IO_BUFFER_SIZE];
+  size_t length = 0;
+  size_t position = 0;
+
+  bool get(int& byte) {
+    if (position == length) {
+      if (remaining == 0) return false;
+      const size_t wanted = remaining < sizeof(buffer) ? remaining : sizeof(buffer);
+      length = file.read(buffer, wanted);
+      if (length != wanted) return false;
+      remaining -= length;
+      position = 0;
+    }
+    byte = buffer[position++];
+    return true;
+  }
+};
+}  // namespace
+
+ResumeSnapshot ResumeSnapshot::instance;
+
+uint32_t ResumeSnapshot::hashFrameBuffer(const uint8_t* frameBuffer) {
+  // FNV-1a over 32-bit words, only used to notice that something was drawn over the page
+  const auto* words = reinterpret_cast<const uint32_t*>(frameBuffer);
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < GfxRenderer::getBufferSize() / sizeof(uint32_t); i++) {
+    hash = (hash ^ words[i]) * 16777619u;
+  }
+  return hash;
+}
+
+void ResumeSnapshot::setPage(const std::string& path, const uint16_t spine, const uint16_t pageNumber,
+                             const GfxRenderer& renderer) {
+  const uint8_t* frameBuffer = renderer.getFrameBuffer();
+  if (!frameBuffer) {
+    hasPage = false;
+    return;
+  }
+  bookPath = path;
+  spineIndex = spine;
+  page = pageNumber;
+  frameHash = hashFrameBuffer(frameBuffer);
+  hasPage = true;
+}
+
+bool ResumeSnapshot::saveToFile(const GfxRenderer& renderer) const {
+  const uint8_t* frameBuffer = renderer.getFrameBuffer();
+  if (!hasPage || !frameBuffer || hashFrameBuffer(frameBuffer) != frameHash) {
+    removeFile();
+    return false;
+  }
+
+  FsFile outputFile;
+  if (!Storage.openFileForWrite("RSM", SNAPSHOT_FILE, outputFile)) {
+    return false;
+  }
+  serialization::writePod(outputFile, SNAPSHOT_FILE_VERSION);
+  serialization::writeString(outputFile, bookPath);
+  serialization::writePod(outputFile, spineIndex);
+  serialization::writePod(outputFile, page);
+  const uint32_t sizeOffset = outputFile.position();
+  uint32_t packedSize = 0;
+  serialization::writePod(outputFile, packedSize);
+
+  PackBitsWriter writer(outputFile);
+  if (!writer.write(frameBuffer, GfxRenderer::getBufferSize())) {
+    LOG_ERR("RSM", "Failed to write snapshot");
+    outputFile.close();
+    removeFile();
+    return false;
+  }
+  packedSize = writer.written();
+  outputFile.seek(sizeOffset);
+  serialization::writePod(outputFile, packedSize);
+  outputFile.close();
+  LOG_DBG("RSM", "Saved spine %u page %u (%lu bytes)", spineIndex, page, packedSize);
+  return true;
+}
+
+bool ResumeSnapshot::showFromFile(const std::string& path, GfxRenderer& renderer) const {
+  FsFile inputFile;
+  if (!Storage.exists(SNAPSHOT_FILE) || !Storage.openFileForRead("RSM", SNAPSHOT_FILE, inputFile)) {
+    return false;
+  }
+
+  uint8_t version;
+  std::string snapshotPath;
+  uint16_t snapshotSpine;
+  uint16_t snapshotPage;
+  uint32_t packedSize;
+  serialization::readPod(inputFile, version);
+  bool shown = false;
+  if (version != SNAPSHOT_FILE_VERSION) {
+    LOG_ERR("RSM", "Deserialization failed: Unknown version %u", version);
+  } else {
+    serialization::readString(inputFile, snapshotPath);
+    serialization::readPod(inputFile, snapshotSpine);
+    serialization::readPod(inputFile, snapshotPage);
+    serialization::readPod(inputFile, packedSize);
+
+    uint8_t* frameBuffer = renderer.getFrameBuffer();
+    if (snapshotPath == path && frameBuffer) {
+      PackBitsReader reader(inputFile, packedSize);
+      shown = reader.read(frameBuffer, GfxRenderer::getBufferSize());
+      if (shown) {
+        renderer.displayBuffer(HalDisplay::HALF_REFRESH);
+        LOG_DBG("RSM", "Resumed spine %u page %u", snapshotSpine, snapshotPage);
+      } else {
+        LOG_ERR("RSM", "Corrupt snapshot");
+        renderer.clearScreen();
+      }
+    }
+  }
+  inputFile.close();
+  removeFile();
+  return shown;
+}
+
+void ResumeSnapshot::removeFile() {
+  if (Storage.exists(SNAPSHOT_FILE)) {
+    Storage.remove(SNAPSHOT_FILE);
+  }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+class GfxRenderer;
+
+// The reader page on screen when the device went to sleep, kept so waking can show it again before the book, its
+// CSS and the section are loaded. The framebuffer already holds the status bar, so no reader state is needed to
+// draw it.
+class ResumeSnapshot {
+  // Static instance
+  static ResumeSnapshot instance;
+
+  std::string bookPath;
+  uint16_t spineIndex = 0;
+  uint16_t page = 0;
+  uint32_t frameHash = 0;  // Framebuffer right after the page was rendered
+  bool hasPage = false;
+
+  static uint32_t hashFrameBuffer(const uint8_t* frameBuffer);
+
+ public:
+  ~ResumeSnapshot() = default;
+
+  // Get singleton instance
+  static ResumeSnapshot& getInstance() { return instance; }
+
+  // Called by the reader after a page is rendered
+  void setPage(const std::string& path, uint16_t spine, uint16_t pageNumber, const GfxRenderer& renderer);
+  void clearPage() { hasPage = false; }
+
+  // Saves the framebuffer if it still shows the last page set, e.g. no menu was opened over it since
+  bool saveToFile(const GfxRenderer& renderer) const;
+
+  // Shows the snapshot when it was taken in bookPath. The file is removed either way, a snapshot is shown once.
+  bool showFromFile(const std::string& path, GfxRenderer& renderer) const;
+  static void removeFile();
+};
+
+// Helper macro to access the snapshot
+#define RESUME_SNAPSHOT ResumeSnapshot::getInstance()
@@ -1,6 +1,7 @@
 #include "SleepActivity.h"
 
 #include <Epub.h>
+#include <FramebufferImageCache.h>
 #include <GfxRenderer.h>
 #include <HalStorage.h>
 #include <I18n.h>
@@ -14,6 +15,33 @@
 #include "images/Logo120.h"
 #include "util/StringUtils.h"
 
+namespace {
+// Stamp for a cover's framebuffer cache: the BMP's size and modification time, so a regenerated cover is not
+// replayed, and the settings baked into the rendered layout
+uint32_t coverCacheStamp(const std::string& coverBmpPath) {
+  FsFile file;
+  if (!Storage.openFileForRead("SLP", coverBmpPath, file)) {
+    return 0;
+  }
+  uint16_t date = 0;
+  uint16_t time = 0;
+  file.getModifyDateTime(&date, &time);
+  const uint32_t fields[] = {static_cast<uint32_t>(file.size()), date, time, SETTINGS.sleepScreenCoverMode,
+                             SETTINGS.sleepScreenCoverFilter};
+  file.close();
+
+  // FNV-1a over the fields
+  uint32_t hash = 2166136261u;
+  for (const uint32_t field : fields) {
+    for (int shift = 0; shift < 32; shift += 8) {
+      hash = (hash ^ ((field >> shift) & 0xFF)) * 16777619u;
+    }
+  }
+  // 0 marks an unstamped cache
+  return hash ? hash : 1;
+}
+}  // namespace
+
 void SleepActivity::onEnter() {
   Activity::onEnter();
   GUI.drawPopup(renderer, tr(STR_ENTERING_SLEEP));
@@ -122,7 +150,8 @@ void SleepActivity::renderDefaultSleepScreen() const {
   renderer.displayBuffer(HalDisplay::HALF_REFRESH);
 }
 
-void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap) const {
+void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap, const std::string& cachePath,
+                                            const uint32_t cacheStamp) const {
   int x, y;
   const auto pageWidth = renderer.getScreenWidth();
   const auto pageHeight = renderer.getScreenHeight();
@@ -170,6 +199,14 @@ void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap) const {
 
   renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
 
+  // Capture each pass in framebuffer layout so the next sleep can skip decoding
+  FramebufferImageCache cache(renderer, cachePath);
+  const bool caching =
+      !cachePath.empty() && cache.beginWrite(0, 0, pageWidth, pageHeight, bitmap.hasGreyscale(), cacheStamp);
+  if (caching) {
+    cache.writePlane(FramebufferImageCache::BW_PLANE);
+  }
+
   if (SETTINGS.sleepScreenCoverFilter == CrossPointSettings::SLEEP_SCREEN_COVER_FILTER::INVERTED_BLACK_AND_WHITE) {
     renderer.invertScreen();
   }
@@ -181,17 +218,70 @@ void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap) const {
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
     renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
+    if (caching) {
+      cache.writePlane(FramebufferImageCache::GRAYSCALE_LSB_PLANE);
+    }
     renderer.copyGrayscaleLsbBuffers();
 
     bitmap.rewindToData();
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
     renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
+    if (caching) {
+      cache.writePlane(FramebufferImageCache::GRAYSCALE_MSB_PLANE);
+    }
     renderer.copyGrayscaleMsbBuffers();
 
     renderer.displayGrayBuffer();
     renderer.setRenderMode(GfxRenderer::BW);
   }
+
+  if (caching) {
+    cache.finishWrite();
+  }
+}
+
+bool SleepActivity::renderCachedSleepScreen(const std::string& cachePath, const uint32_t cacheStamp) const {
+  FramebufferImageCache cache(renderer, cachePath);
+  if (!cache.open(cacheStamp)) {
+    return false;
+  }
+
+  const bool hasGreyscale = cache.isGreyscaleSource() &&
+                            SETTINGS.sleepScreenCoverFilter == CrossPointSettings::SLEEP_SCREEN_COVER_FILTER::NO_FILTER;
+  if (hasGreyscale && !cache.hasPlane(FramebufferImageCache::GRAYSCALE_MSB_PLANE)) {
+    // Captured while a filter was active, the grayscale passes were never rendered
+    return false;
+  }
+
+  renderer.clearScreen();
+  if (!cache.drawPlane(FramebufferImageCache::BW_PLANE)) {
+    return false;
+  }
+  LOG_DBG("SLP", "Rendering cached sleep cover: %s", cachePath.c_str());
+
+  if (SETTINGS.sleepScreenCoverFilter == CrossPointSettings::SLEEP_SCREEN_COVER_FILTER::INVERTED_BLACK_AND_WHITE) {
+    renderer.invertScreen();
+  }
+
+  renderer.displayBuffer(HalDisplay::HALF_REFRESH);
+
+  if (hasGreyscale) {
+    renderer.clearScreen(0x00);
+    if (!cache.drawPlane(FramebufferImageCache::GRAYSCALE_LSB_PLANE)) {
+      return true;
+    }
+    renderer.copyGrayscaleLsbBuffers();
+
+    renderer.clearScreen(0x00);
+    if (!cache.drawPlane(FramebufferImageCache::GRAYSCALE_MSB_PLANE)) {
+      return true;
+    }
+    renderer.copyGrayscaleMsbBuffers();
+
+    renderer.displayGrayBuffer();
+  }
+  return true;
 }
 
 void SleepActivity::renderCoverSleepScreen() const {
@@ -261,12 +351,18 @@ void SleepActivity::renderCoverSleepScreen() const {
     return (this->*renderNoCoverSleepScreen)();
   }
 
+  const std::string cachePath = FramebufferImageCache::pathFor(coverBmpPath);
+  const uint32_t cacheStamp = coverCacheStamp(coverBmpPath);
+  if (renderCachedSleepScreen(cachePath, cacheStamp)) {
+    return;
+  }
+
   FsFile file;
   if (Storage.openFileForRead("SLP", coverBmpPath, file)) {
     Bitmap bitmap(file);
     if (bitmap.parseHeaders() == BmpReaderError::Ok) {
       LOG_DBG("SLP", "Rendering sleep cover: %s", coverBmpPath.c_str());
-      renderBitmapSleepScreen(bitmap);
+      renderBitmapSleepScreen(bitmap, cachePath, cacheStamp);
       return;
     }
   }
@@ -1,4 +1,7 @@
 #pragma once
+#include <cstdint>
+#include <string>
+
 #include "../Activity.h"
 
 class Bitmap;
@@ -13,6 +16,7 @@ class SleepActivity final : public Activity {
   void renderDefaultSleepScreen() const;
   void renderCustomSleepScreen() const;
   void renderCoverSleepScreen() const;
-  void renderBitmapSleepScreen(const Bitmap& bitmap) const;
+  void renderBitmapSleepScreen(const Bitmap& bitmap, const std::string& cachePath = "", uint32_t cacheStamp = 0) const;
+  bool renderCachedSleepScreen(const std::string& cachePath, uint32_t cacheStamp) const;
   void renderBlankSleepScreen() const;
 };
@@ -14,35 +14,13 @@
 namespace {
 constexpr int FOV_RADIUS = 8;
 
-// Bresenham line-of-sight: returns true if no wall blocks the line from (x0,y0) to (x1,y1)
-bool hasLineOfSight(const game::Tile* tiles, int x0, int y0, int x1, int y1) {
-  int dx = abs(x1 - x0);
-  int dy = -abs(y1 - y0);
-  int sx = x0 < x1 ? 1 : -1;
-  int sy = y0 < y1 ? 1 : -1;
-  int err = dx + dy;
-
-  int cx = x0, cy = y0;
-  while (true) {
-    // Skip the starting tile check
-    if ((cx != x0 || cy != y0) && (cx != x1 || cy != y1)) {
-      if (tiles[cy * game::MAP_WIDTH + cx] == game::Tile::Wall) {
-        return false;
-      }
-    }
-    if (cx == x1 && cy == y1) break;
-    int e2 = 2 * err;
-    if (e2 >= dy) {
-      err += dy;
-      cx += sx;
-    }
-    if (e2 <= dx) {
-      err += dx;
-      cy += sy;
-    }
-  }
-  return true;
-}
+// Recursive shadowcasting works on one octant at a time. Each row maps (col, row) offsets in the
+// octant onto map deltas: dx = col * xx + row * xy, dy = col * yx + row * yy.
+constexpr int8_t OCTANTS[8][4] = {{1, 0, 0, 1},  {0, 1, 1, 0},  {0, -1, 1, 0},  {-1, 0, 0, 1},
+                                  {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}};
+
+static_assert(game::MAP_WIDTH % 8 == 0, "visibility rows must start on a byte boundary");
+static_assert(game::MAX_MONSTERS <= 32, "monstersInView holds one bit per monster");
 
 // Calculate total attack bonus from equipped weapons
 int equippedAttackBonus() {
@@ -172,6 +150,7 @@ void GameActivity::openGameMenu() {
   auto onResume = [this] {
     xSemaphoreTake(renderingMutex, portMAX_DELAY);
     exitActivity();
+    gameRenderer.invalidate();  // The menu drew over the whole screen
     xSemaphoreGive(renderingMutex);
     updateRequired = true;
   };
@@ -413,13 +392,16 @@ void GameActivity::processMonsterTurns() {
     int dx = static_cast<int>(p.x) - m.x;
     int dy = static_cast<int>(p.y) - m.y;
     int dist2 = dx * dx + dy * dy;
+    // The view bit is from the FOV pass before the player acted, so the range is also checked against where the
+    // player stands now
+    const bool seesPlayer = dist2 <= FOV_RADIUS * FOV_RADIUS && (monstersInView & (1u << i));
 
     // State transitions
     auto state = static_cast<game::MonsterState>(m.state);
 
     if (state == game::MonsterState::Asleep) {
       // Wake up if player is nearby and visible
-      if (dist2 <= FOV_RADIUS * FOV_RADIUS && visible[m.y * game::MAP_WIDTH + m.x]) {
+      if (seesPlayer) {
         // Wake chance based on distance — closer = more likely
         game::Rng rng(p.turnCount ^ (m.x * 17 + m.y * 13 + i));
         int wakeChance = 80 - dist2;  // Very likely when close
@@ -433,7 +415,7 @@ void GameActivity::processMonsterTurns() {
 
     if (state == game::MonsterState::Wandering) {
       // Become hostile if player is visible and close
-      if (dist2 <= FOV_RADIUS * FOV_RADIUS && visible[m.y * game::MAP_WIDTH + m.x]) {
+      if (seesPlayer) {
         m.state = static_cast<uint8_t>(game::MonsterState::Hostile);
         state = game::MonsterState::Hostile;
       } else {
@@ -616,6 +598,7 @@ void GameActivity::loadOrGenerateLevel() {
   // Clear fog
   memset(fogOfWar, 0, sizeof(fogOfWar));
   memset(visible, 0, sizeof(visible));
+  monstersInView = 0;
 
   // If we have saved state for this level, overlay it
   if (GameSave::hasLevel(p.dungeonDepth)) {
@@ -637,24 +620,66 @@ void GameActivity::saveCurrentLevel() {
 void GameActivity::computeVisibility() {
   auto& p = GAME_STATE.player;
 
-  memset(visible, 0, sizeof(visible));
+  // Only the rows the previous pass could have touched need clearing
+  memset(visible + visibleFirstRow * game::MAP_WIDTH / 8, 0,
+         (visibleLastRow - visibleFirstRow + 1) * game::MAP_WIDTH / 8);
+  visibleFirstRow = static_cast<uint8_t>(std::max(0, static_cast<int>(p.y) - FOV_RADIUS));
+  visibleLastRow = static_cast<uint8_t>(std::min(game::MAP_HEIGHT - 1, static_cast<int>(p.y) + FOV_RADIUS));
 
-  // For each tile within FOV_RADIUS, check line of sight
-  int startX = std::max(0, static_cast<int>(p.x) - FOV_RADIUS);
-  int endX = std::min(game::MAP_WIDTH - 1, static_cast<int>(p.x) + FOV_RADIUS);
-  int startY = std::max(0, static_cast<int>(p.y) - FOV_RADIUS);
-  int endY = std::min(game::MAP_HEIGHT - 1, static_cast<int>(p.y) + FOV_RADIUS);
+  game::setTileVisible(visible, p.x, p.y);
+  game::fogSetExplored(fogOfWar, p.x, p.y);
+  for (const auto& octant : OCTANTS) {
+    castLight(1, 1.0f, 0.0f, octant[0], octant[1], octant[2], octant[3]);
+  }
 
-  for (int y = startY; y <= endY; y++) {
-    for (int x = startX; x <= endX; x++) {
-      int dx = x - p.x;
-      int dy = y - p.y;
-      if (dx * dx + dy * dy > FOV_RADIUS * FOV_RADIUS) continue;
+  // Monsters standing on a lit tile, for the wake and hostility checks of the next monster turn
+  monstersInView = 0;
+  for (uint8_t i = 0; i < monsterCount; i++) {
+    if (monsters[i].hp > 0 && game::isTileVisible(visible, monsters[i].x, monsters[i].y)) {
+      monstersInView |= 1u << i;
+    }
+  }
+}
 
-      if (hasLineOfSight(tiles, p.x, p.y, x, y)) {
-        visible[y * game::MAP_WIDTH + x] = true;
+// Lights rows [row, FOV_RADIUS] of one octant between two slopes, recursing past each wall run
+void GameActivity::castLight(const int row, float startSlope, const float endSlope, const int xx, const int xy,
+                             const int yx, const int yy) {
+  if (startSlope < endSlope) return;
+  const auto& p = GAME_STATE.player;
+
+  float nextStartSlope = startSlope;
+  for (int depth = row; depth <= FOV_RADIUS; depth++) {
+    bool blocked = false;
+    for (int col = -depth; col <= 0; col++) {
+      const float leftSlope = (col - 0.5f) / (-depth + 0.5f);
+      const float rightSlope = (col + 0.5f) / (-depth - 0.5f);
+      if (startSlope < rightSlope) continue;
+      if (endSlope > leftSlope) break;
+
+      const int dx = col * xx - depth * xy;
+      const int dy = col * yx - depth * yy;
+      const int x = p.x + dx;
+      const int y = p.y + dy;
+      const bool inMap = x >= 0 && x < game::MAP_WIDTH && y >= 0 && y < game::MAP_HEIGHT;
+      if (inMap && dx * dx + dy * dy <= FOV_RADIUS * FOV_RADIUS) {
+        game::setTileVisible(visible, x, y);
         game::fogSetExplored(fogOfWar, x, y);
       }
+
+      const bool opaque = !inMap || tiles[y * game::MAP_WIDTH + x] == game::Tile::Wall;
+      if (blocked) {
+        if (opaque) {
+          nextStartSlope = rightSlope;
+          continue;
+        }
+        blocked = false;
+        startSlope = nextStartSlope;
+      } else if (opaque && depth < FOV_RADIUS) {
+        blocked = true;
+        castLight(depth + 1, startSlope, leftSlope, xx, xy, yx, yy);
+        nextStartSlope = rightSlope;
+      }
     }
+    if (blocked) break;
   }
 }
@@ -21,8 +21,11 @@ class GameActivity final : public ActivityWithSubactivity {
   uint8_t monsterCount = 0;
   uint8_t itemCount = 0;
 
-  // Visibility cache (computed per turn)
-  bool visible[game::MAP_SIZE];
+  // Visibility cache (computed per turn), a bitfield laid out like fogOfWar
+  uint8_t visible[game::FOG_SIZE];
+  uint8_t visibleFirstRow = 0;  // Rows the last FOV pass may have marked
+  uint8_t visibleLastRow = 0;
+  uint32_t monstersInView = 0;  // Bit per monster index, set by the FOV pass
 
   // Rendering
   GameRenderer gameRenderer;
@@ -41,6 +44,7 @@ class GameActivity final : public ActivityWithSubactivity {
   void loadOrGenerateLevel();
   void saveCurrentLevel();
   void computeVisibility();
+  void castLight(int row, float startSlope, float endSlope, int xx, int xy, int yx, int yy);
   void handleMove(int dx, int dy);
   void handleAction();
   void processMonsterTurns();
@@ -6,6 +6,7 @@
 #include <HalStorage.h>
 #include <I18n.h>
 #include <Logging.h>
+#include <PerfTrace.h>
 
 #include "../home/HomeActivity.h"
 #include "../home/StatsManager.h"
@@ -18,12 +19,12 @@
 #include "KOReaderSyncActivity.h"
 #include "MappedInputManager.h"
 #include "RecentBooksStore.h"
+#include "ResumeSnapshot.h"
 #include "components/UITheme.h"
 #include "fontIds.h"
 
 
 namespace {
-// pagesPerRefresh now comes from SETTINGS.getRefreshFrequency()
 constexpr unsigned long skipChapterMs = 700;
 constexpr unsigned long goHomeMs = 1000;
 constexpr int statusBarMargin = 19;
@@ -72,6 +73,8 @@ void EpubReaderActivity::onEnter() {
   // Configure screen orientation based on settings
   // NOTE: This affects layout math and must be applied before any render calls.
   applyReaderOrientation(renderer, SETTINGS.orientation);
+  // The first page clears whatever the previous screen left behind
+  renderer.requestHalfRefresh();
 
   epub->setupCacheDir();
 
@@ -124,6 +127,7 @@ void EpubReaderActivity::onExit() {
     sessionStartTime = 0;
   }
 
+  RESUME_SNAPSHOT.clearPage();
   APP_STATE.readerActivityLoadCount = 0;
   APP_STATE.saveToFile();
   StatsManager::getInstance().save();
@@ -597,11 +601,15 @@ void EpubReaderActivity::render(Activity::RenderLock&& lock) {
 
       if (!section->createSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
                                       SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
-                                      viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.embeddedStyle, popupFn)) {
+                                      viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.embeddedStyle, popupFn,
+                                      SETTINGS.prerenderImages)) {
         LOG_ERR("ERS", "Failed to persist page data to SD");
         section.reset();
         return;
       }
+      if (SETTINGS.prerenderImages) {
+        section->prerenderImages(orientedMarginLeft, orientedMarginTop);
+      }
     } else {
       LOG_DBG("ERS", "Cache found, skipping build...");
     }
@@ -665,6 +673,7 @@ void EpubReaderActivity::render(Activity::RenderLock&& lock) {
     const auto start = millis();
     renderContents(std::move(p), orientedMarginTop, orientedMarginRight, orientedMarginBottom, orientedMarginLeft);
     LOG_DBG("ERS", "Rendered page in %dms", millis() - start);
+    RESUME_SNAPSHOT.setPage(epub->getPath(), currentSpineIndex, section->currentPage, renderer);
     renderer.clearFontCache();
   }
   saveProgress(currentSpineIndex, section->currentPage, section->pageCount);
@@ -703,6 +712,8 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
   // Force special handling for pages with images when anti-aliasing is on
   bool imagePageWithAA = page->hasImages() && SETTINGS.textAntiAliasing;
 
+  perf::Accumulator bwRenderTime(perf::Metric::RENDER_BW);
+  bwRenderTime.begin();
   page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
 
   // Draw bookmark icon in top right if bookmarked
@@ -718,6 +729,7 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
     }
   }
   renderStatusBar(orientedMarginRight, orientedMarginBottom, orientedMarginLeft);
+  bwRenderTime.end();
   if (imagePageWithAA) {
     // Double FAST_REFRESH with selective image blanking (pablohc's technique):
     // HALF_REFRESH sets particles too firmly for the grayscale LUT to adjust.
@@ -736,13 +748,11 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
     } else {
       renderer.displayBuffer(HalDisplay::HALF_REFRESH);
     }
-    // Double FAST_REFRESH handles ghosting for image pages; don't count toward full refresh cadence
-  } else if (pagesUntilFullRefresh <= 1) {
-    renderer.displayBuffer(HalDisplay::HALF_REFRESH);
-    pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
+    // The pair only cleans the image area, so both refreshes add their changed tiles to the ghosting debt like any
+    // other fast refresh, and the text around the image still gets its periodic half refresh
   } else {
-    renderer.displayBuffer();
-    pagesUntilFullRefresh--;
+    renderer.setRefreshBudget(SETTINGS.getRefreshFrequency());
+    renderer.displayChanges();
   }
 
   // Save bw buffer to reset buffer state after grayscale data sync
@@ -751,6 +761,8 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
   // grayscale rendering
   // TODO: Only do this if font supports it
   if (SETTINGS.textAntiAliasing) {
+    perf::Accumulator grayscaleRenderTime(perf::Metric::RENDER_GRAYSCALE);
+    grayscaleRenderTime.begin();
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
     page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
@@ -761,6 +773,7 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
     page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
     renderer.copyGrayscaleMsbBuffers();
+    grayscaleRenderTime.end();
 
     // display grayscale part
     renderer.displayGrayBuffer();
@@ -50,6 +50,8 @@ void TxtReaderActivity::onEnter() {
   }
 
   txt->setupCacheDir();
+  // The first page clears whatever the previous screen left behind
+  renderer.requestHalfRefresh();
 
   // Save current txt as last opened file and add to recent books
   auto filePath = txt->getPath();
@@ -425,13 +427,8 @@ void TxtReaderActivity::renderPage() {
   renderLines();
   renderStatusBar(orientedMarginRight, orientedMarginBottom, orientedMarginLeft);
 
-  if (pagesUntilFullRefresh <= 1) {
-    renderer.displayBuffer(HalDisplay::HALF_REFRESH);
-    pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
-  } else {
-    renderer.displayBuffer();
-    pagesUntilFullRefresh--;
-  }
+  renderer.setRefreshBudget(SETTINGS.getRefreshFrequency());
+  renderer.displayChanges();
 
   // Grayscale rendering pass (for anti-aliased fonts)
   if (SETTINGS.textAntiAliasing) {
@@ -12,7 +12,6 @@ class TxtReaderActivity final : public ActivityWithSubactivity {
 
   int currentPage = 0;
   int totalPages = 1;
-  int pagesUntilFullRefresh = 0;
 
   const std::function<void()> onGoBack;
   const std::function<void()> onGoHome;
@@ -33,6 +33,8 @@ void XtcReaderActivity::onEnter() {
   }
 
   xtc->setupCacheDir();
+  // The first page clears whatever the previous screen left behind
+  renderer.requestHalfRefresh();
 
   // Load saved progress
   loadProgress();
@@ -242,14 +244,9 @@ void XtcReaderActivity::renderPage() {
       }
     }
 
-    // Display BW with conditional refresh based on pagesUntilFullRefresh
-    if (pagesUntilFullRefresh <= 1) {
-      renderer.displayBuffer(HalDisplay::HALF_REFRESH);
-      pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
-    } else {
-      renderer.displayBuffer();
-      pagesUntilFullRefresh--;
-    }
+    // Display BW, refreshing what changed
+    renderer.setRefreshBudget(SETTINGS.getRefreshFrequency());
+    renderer.displayChanges();
 
     // Pass 2: LSB buffer - mark DARK gray only (XTH value 1)
     // In LUT: 0 bit = apply gray effect, 1 bit = untouched
@@ -321,14 +318,9 @@ void XtcReaderActivity::renderPage() {
 
   // XTC pages already have status bar pre-rendered, no need to add our own
 
-  // Display with appropriate refresh
-  if (pagesUntilFullRefresh <= 1) {
-    renderer.displayBuffer(HalDisplay::HALF_REFRESH);
-    pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
-  } else {
-    renderer.displayBuffer();
-    pagesUntilFullRefresh--;
-  }
+  // Display what changed, half refreshing when the ghosting budget runs out
+  renderer.setRefreshBudget(SETTINGS.getRefreshFrequency());
+  renderer.displayChanges();
 
   LOG_DBG("XTR", "Rendered page %lu/%lu (%u-bit)", currentPage + 1, xtc->getPageCount(), bitDepth);
 }
@@ -1,9 +1,12 @@
 #include "UITheme.h"
 
+#include <FramebufferImageCache.h>
 #include <GfxRenderer.h>
+#include <HalStorage.h>
 #include <Logging.h>
 
 #include <memory>
+#include <vector>
 
 #include "MappedInputManager.h"
 #include "RecentBooksStore.h"
@@ -14,6 +17,8 @@
 
 namespace {
 constexpr int SKIP_PAGE_MS = 700;
+// Thumbnail caches drawn by the current screen, with their planes loaded
+std::vector<std::unique_ptr<FramebufferImageCache>> loadedThumbs;
 }  // namespace
 
 UITheme UITheme::instance;
@@ -74,6 +79,62 @@ std::string UITheme::getCoverThumbPath(std::string coverBmpPath, int coverHeight
   return coverBmpPath;
 }
 
+int UITheme::drawCoverThumb(const GfxRenderer& renderer, const std::string& thumbBmpPath, const int x, const int y,
+                            const int maxWidth, const int maxHeight, const bool cropToFit) {
+  const auto matches = [&](const FramebufferImageCache& cache) {
+    return cache.getX() == x && cache.getY() == y && cache.getHeight() == maxHeight &&
+           (maxWidth <= 0 || cache.getWidth() == maxWidth);
+  };
+
+  const std::string cachePath = FramebufferImageCache::pathFor(thumbBmpPath);
+  for (auto it = loadedThumbs.begin(); it != loadedThumbs.end(); ++it) {
+    if ((*it)->getPath() != cachePath) {
+      continue;
+    }
+    if (matches(**it) && (*it)->drawPlane(FramebufferImageCache::BW_PLANE)) {
+      return (*it)->getWidth();
+    }
+    loadedThumbs.erase(it);
+    break;
+  }
+
+  // Keep the planes in RAM so redraws of the same screen don't read the cache from the SD card again
+  auto cache = std::make_unique<FramebufferImageCache>(renderer, cachePath);
+  if (cache->open() && matches(*cache) && cache->loadPlanes() && cache->drawPlane(FramebufferImageCache::BW_PLANE)) {
+    const int width = cache->getWidth();
+    loadedThumbs.push_back(std::move(cache));
+    return width;
+  }
+  cache.reset();
+
+  FsFile file;
+  if (!Storage.openFileForRead("HOME", thumbBmpPath, file)) {
+    return 0;
+  }
+  Bitmap bitmap(file);
+  if (bitmap.parseHeaders() != BmpReaderError::Ok) {
+    file.close();
+    return 0;
+  }
+  const int width = maxWidth > 0 ? maxWidth : bitmap.getWidth();
+  float cropX = 0;
+  if (cropToFit) {
+    const float ratio = static_cast<float>(bitmap.getWidth()) / static_cast<float>(bitmap.getHeight());
+    cropX = 1.0f - (static_cast<float>(width) / static_cast<float>(maxHeight)) / ratio;
+  }
+  renderer.drawBitmap(bitmap, x, y, width, maxHeight, cropX);
+  file.close();
+
+  FramebufferImageCache newCache(renderer, cachePath);
+  if (newCache.beginWrite(x, y, width, maxHeight, false)) {
+    newCache.writePlane(FramebufferImageCache::BW_PLANE);
+    newCache.finishWrite();
+  }
+  return width;
+}
+
+void UITheme::releaseCoverThumbs() { loadedThumbs.clear(); }
+
 UIIcon UITheme::getFileIcon(std::string filename) {
   if (filename.back() == '/') {
     return Folder;
@@ -21,6 +21,13 @@ class UITheme {
   static int getNumberOfItemsPerPage(const GfxRenderer& renderer, bool hasHeader, bool hasTabBar, bool hasButtonHints,
                                      bool hasSubtitle);
   static std::string getCoverThumbPath(std::string coverBmpPath, int coverHeight);
+  // Draw a cover thumbnail, blitting from its native framebuffer cache when it matches this placement and creating
+  // the cache otherwise. A maxWidth of 0 keeps the thumbnail width, cropToFit crops the sides to the rect ratio.
+  // Returns the drawn width, or 0 on failure.
+  static int drawCoverThumb(const GfxRenderer& renderer, const std::string& thumbBmpPath, int x, int y, int maxWidth,
+                            int maxHeight, bool cropToFit = false);
+  // Free the thumbnails drawCoverThumb keeps in RAM, when leaving the screen or after regenerating a thumbnail
+  static void releaseCoverThumbs();
   static UIIcon getFileIcon(std::string filename);
 
  private:
@@ -339,8 +339,7 @@ void BaseTheme::drawTabBar(const GfxRenderer& renderer, const Rect rect, const s
 // Draw the "Recent Book" cover card on the home screen
 // TODO: Refactor method to make it cleaner, split into smaller methods
 void BaseTheme::drawRecentBookCover(GfxRenderer& renderer, Rect rect, const std::vector<RecentBook>& recentBooks,
-                                    const int selectorIndex, bool& coverRendered, bool& coverBufferStored,
-                                    bool& bufferRestored, std::function<bool()> storeCoverBuffer) const {
+                                    const int selectorIndex) const {
   const bool hasContinueReading = !recentBooks.empty();
   const bool bookSelected = hasContinueReading && selectorIndex == 0;
 
@@ -399,59 +398,46 @@ void BaseTheme::drawRecentBookCover(GfxRenderer& renderer, Rect rect, const std:
   const int bookmarkY = bookY + 5;
 
   // Draw book card regardless, fill with message based on `hasContinueReading`
+  bool coverRendered = false;
   {
     // Draw cover image as background if available (inside the box)
-    // Only load from SD on first render, then use stored buffer
-
-    if (hasContinueReading && !recentBooks[0].coverBmpPath.empty() && !coverRendered) {
+    // The thumbnail is blitted from its framebuffer cache after the first render
+    if (hasContinueReading && !recentBooks[0].coverBmpPath.empty()) {
       const std::string coverBmpPath =
           UITheme::getCoverThumbPath(recentBooks[0].coverBmpPath, BaseMetrics::values.homeCoverHeight);
 
-      // First time: load cover from SD and render
-      FsFile file;
-      if (Storage.openFileForRead("HOME", coverBmpPath, file)) {
-        Bitmap bitmap(file);
-        if (bitmap.parseHeaders() == BmpReaderError::Ok) {
-          LOG_DBG("THEME", "Rendering bmp");
-
-          // Draw the cover image (bookWidth and bookHeight already match image aspect ratio)
-          renderer.drawBitmap(bitmap, bookX, bookY, bookWidth, bookHeight);
-
-          // Draw border around the card
-          renderer.drawRect(bookX, bookY, bookWidth, bookHeight);
-
-          // Draw progress badge in top-right of cover
-          if (recentBooks[0].progressPercent >= 0) {
-            char progressStr[8];
-            snprintf(progressStr, sizeof(progressStr), "%d%%", recentBooks[0].progressPercent);
-            int textW = renderer.getTextWidth(SMALL_FONT_ID, progressStr);
-            int badgeW = textW + 8;
-            int badgeH = 16;
-            int badgeX = bookX + bookWidth - badgeW - 4;
-            int badgeY = bookY + 4;
-            renderer.fillRect(badgeX, badgeY, badgeW, badgeH, false);
-            renderer.drawRect(badgeX, badgeY, badgeW, badgeH, true);
-            renderer.drawText(SMALL_FONT_ID, badgeX + 4, badgeY + 2, progressStr, true);
-          }
+      // Draw the cover image (bookWidth and bookHeight already match image aspect ratio)
+      if (UITheme::drawCoverThumb(renderer, coverBmpPath, bookX, bookY, bookWidth, bookHeight) > 0) {
+        coverRendered = true;
+
+        // Draw border around the card
+        renderer.drawRect(bookX, bookY, bookWidth, bookHeight);
 
-          // No bookmark ribbon when cover is shown - it would just cover the art
+        // Draw progress badge in top-right of cover
+        if (recentBooks[0].progressPercent >= 0) {
+          char progressStr[8];
+          snprintf(progressStr, sizeof(progressStr), "%d%%", recentBooks[0].progressPercent);
+          int textW = renderer.getTextWidth(SMALL_FONT_ID, progressStr);
+          int badgeW = textW + 8;
+          int badgeH = 16;
+          int badgeX = bookX + bookWidth - badgeW - 4;
+          int badgeY = bookY + 4;
+          renderer.fillRect(badgeX, badgeY, badgeW, badgeH, false);
+          renderer.drawRect(badgeX, badgeY, badgeW, badgeH, true);
+          renderer.drawText(SMALL_FONT_ID, badgeX + 4, badgeY + 2, progressStr, true);
+        }
 
-          // Store the buffer with cover image for fast navigation
-          coverBufferStored = storeCoverBuffer();
-          coverRendered = true;
+        // No bookmark ribbon when cover is shown - it would just cover the art
 
-          // First render: if selected, draw selection indicators now
-          if (bookSelected) {
-            LOG_DBG("THEME", "Drawing selection");
-            renderer.drawRect(bookX + 1, bookY + 1, bookWidth - 2, bookHeight - 2);
-            renderer.drawRect(bookX + 2, bookY + 2, bookWidth - 4, bookHeight - 4);
-          }
+        // Selection indicators
+        if (bookSelected) {
+          renderer.drawRect(bookX + 1, bookY + 1, bookWidth - 2, bookHeight - 2);
+          renderer.drawRect(bookX + 2, bookY + 2, bookWidth - 4, bookHeight - 4);
         }
-        file.close();
       }
     }
 
-    if (!bufferRestored && !coverRendered) {
+    if (!coverRendered) {
       // No cover image: draw border or fill, plus bookmark as visual flair
       if (bookSelected) {
         renderer.fillRect(bookX, bookY, bookWidth, bookHeight);
@@ -483,15 +469,6 @@ void BaseTheme::drawRecentBookCover(GfxRenderer& renderer, Rect rect, const std:
         renderer.fillPolygon(xPoints, yPoints, 5, !bookSelected);
       }
     }
-
-    // If buffer was restored, draw selection indicators if needed
-    if (bufferRestored && bookSelected && coverRendered) {
-      // Draw selection border (no bookmark inversion needed since cover has no bookmark)
-      renderer.drawRect(bookX + 1, bookY + 1, bookWidth - 2, bookHeight - 2);
-      renderer.drawRect(bookX + 2, bookY + 2, bookWidth - 4, bookHeight - 4);
-    } else if (!coverRendered && !bufferRestored) {
-      // Selection border already handled above in the no-cover case
-    }
   }
 
   if (hasContinueReading) {
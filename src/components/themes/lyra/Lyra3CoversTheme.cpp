@@ -1,7 +1,6 @@
 #include "Lyra3CoversTheme.h"
 
 #include <GfxRenderer.h>
-#include <HalStorage.h>
 
 #include <cstdint>
 #include <string>
@@ -19,8 +18,7 @@ int coverWidth = 0;
 }  // namespace
 
 void Lyra3CoversTheme::drawRecentBookCover(GfxRenderer& renderer, Rect rect, const std::vector<RecentBook>& recentBooks,
-                                           const int selectorIndex, bool& coverRendered, bool& coverBufferStored,
-                                           bool& bufferRestored, std::function<bool()> storeCoverBuffer) const {
+                                           const int selectorIndex) const {
   const int tileWidth = (rect.width - 2 * Lyra3CoversMetrics::values.contentSidePadding) / 3;
   const int tileHeight = rect.height;
   const int bookTitleHeight = tileHeight - Lyra3CoversMetrics::values.homeCoverHeight - hPaddingInSelection;
@@ -29,92 +27,72 @@ void Lyra3CoversTheme::drawRecentBookCover(GfxRenderer& renderer, Rect rect, con
 
   // Draw book card regardless, fill with message based on `hasContinueReading`
   // Draw cover image as background if available (inside the box)
-  // Only load from SD on first render, then use stored buffer
+  // Thumbnails are blitted from their framebuffer caches after the first render
   if (hasContinueReading) {
-    if (!coverRendered) {
-      for (int i = 0;
-           i < std::min(static_cast<int>(recentBooks.size()), Lyra3CoversMetrics::values.homeRecentBooksCount); i++) {
-        std::string coverPath = recentBooks[i].coverBmpPath;
-        bool hasCover = true;
-        int tileX = Lyra3CoversMetrics::values.contentSidePadding + tileWidth * i;
-        if (coverPath.empty()) {
+    for (int i = 0; i < std::min(static_cast<int>(recentBooks.size()), Lyra3CoversMetrics::values.homeRecentBooksCount);
+         i++) {
+      std::string coverPath = recentBooks[i].coverBmpPath;
+      bool hasCover = true;
+      int tileX = Lyra3CoversMetrics::values.contentSidePadding + tileWidth * i;
+      if (coverPath.empty()) {
+        hasCover = false;
+      } else {
+        const std::string coverBmpPath =
+            UITheme::getCoverThumbPath(coverPath, Lyra3CoversMetrics::values.homeCoverHeight);
+
+        if (UITheme::drawCoverThumb(renderer, coverBmpPath, tileX + hPaddingInSelection, tileY + hPaddingInSelection,
+                                    tileWidth - 2 * hPaddingInSelection, Lyra3CoversMetrics::values.homeCoverHeight,
+                                    true) == 0) {
           hasCover = false;
-        } else {
-          const std::string coverBmpPath =
-              UITheme::getCoverThumbPath(coverPath, Lyra3CoversMetrics::values.homeCoverHeight);
-
-          // First time: load cover from SD and render
-          FsFile file;
-          if (Storage.openFileForRead("HOME", coverBmpPath, file)) {
-            Bitmap bitmap(file);
-            if (bitmap.parseHeaders() == BmpReaderError::Ok) {
-              float coverHeight = static_cast<float>(bitmap.getHeight());
-              float coverWidth = static_cast<float>(bitmap.getWidth());
-              float ratio = coverWidth / coverHeight;
-              const float tileRatio = static_cast<float>(tileWidth - 2 * hPaddingInSelection) /
-                                      static_cast<float>(Lyra3CoversMetrics::values.homeCoverHeight);
-              float cropX = 1.0f - (tileRatio / ratio);
-
-              renderer.drawBitmap(bitmap, tileX + hPaddingInSelection, tileY + hPaddingInSelection,
-                                  tileWidth - 2 * hPaddingInSelection, Lyra3CoversMetrics::values.homeCoverHeight,
-                                  cropX);
-            } else {
-              hasCover = false;
-            }
-            file.close();
-          }
         }
-        // Draw either way
-        renderer.drawRect(tileX + hPaddingInSelection, tileY + hPaddingInSelection, tileWidth - 2 * hPaddingInSelection,
-                          Lyra3CoversMetrics::values.homeCoverHeight, true);
+      }
+      // Draw either way
+      renderer.drawRect(tileX + hPaddingInSelection, tileY + hPaddingInSelection, tileWidth - 2 * hPaddingInSelection,
+                        Lyra3CoversMetrics::values.homeCoverHeight, true);
+
+      if (!hasCover) {
+        // Render empty cover
+        renderer.fillRect(tileX + hPaddingInSelection,
+                          tileY + hPaddingInSelection + (Lyra3CoversMetrics::values.homeCoverHeight / 3),
+                          tileWidth - 2 * hPaddingInSelection, 2 * Lyra3CoversMetrics::values.homeCoverHeight / 3,
+                          true);
+        renderer.drawIcon(CoverIcon, tileX + hPaddingInSelection + 24, tileY + hPaddingInSelection + 24, 32, 32);
+      }
 
-        if (!hasCover) {
-          // Render empty cover
-          renderer.fillRect(tileX + hPaddingInSelection,
-                            tileY + hPaddingInSelection + (Lyra3CoversMetrics::values.homeCoverHeight / 3),
-                            tileWidth - 2 * hPaddingInSelection, 2 * Lyra3CoversMetrics::values.homeCoverHeight / 3,
-                            true);
-          renderer.drawIcon(CoverIcon, tileX + hPaddingInSelection + 24, tileY + hPaddingInSelection + 24, 32, 32);
+      // Draw progress badge in bottom-right of cover
+      if (recentBooks[i].progressPercent >= 0) {
+        bool isComplete = (recentBooks[i].progressPercent >= 100);
+        char progressStr[8];
+        if (!isComplete) {
+          snprintf(progressStr, sizeof(progressStr), "%d%%", recentBooks[i].progressPercent);
         }
 
-        // Draw progress badge in bottom-right of cover
-        if (recentBooks[i].progressPercent >= 0) {
-          bool isComplete = (recentBooks[i].progressPercent >= 100);
-          char progressStr[8];
-          if (!isComplete) {
-            snprintf(progressStr, sizeof(progressStr), "%d%%", recentBooks[i].progressPercent);
-          }
-
-          int textH = renderer.getTextHeight(SMALL_FONT_ID);
-          int badgeH = textH + 6;
-          int badgeW;
-          if (isComplete) {
-            badgeW = badgeH;  // square for checkmark
-          } else {
-            badgeW = renderer.getTextWidth(SMALL_FONT_ID, progressStr) + 8;
-          }
-          int badgeX = tileX + tileWidth - hPaddingInSelection - badgeW - 2;
-          int badgeY = tileY + hPaddingInSelection + Lyra3CoversMetrics::values.homeCoverHeight - badgeH - 4;
-          renderer.fillRect(badgeX, badgeY, badgeW, badgeH, false);  // white fill
-          renderer.drawRect(badgeX, badgeY, badgeW, badgeH, true);   // black border
-
-          if (isComplete) {
-            // Draw checkmark ✓ using lines
-            int cx = badgeX + badgeW / 2;
-            int cy = badgeY + badgeH / 2;
-            renderer.drawLine(cx - 5, cy, cx - 1, cy + 4, true);
-            renderer.drawLine(cx - 1, cy + 4, cx + 5, cy - 4, true);
-            // Thicken the lines
-            renderer.drawLine(cx - 5, cy + 1, cx - 1, cy + 5, true);
-            renderer.drawLine(cx - 1, cy + 5, cx + 5, cy - 3, true);
-          } else {
-            renderer.drawText(SMALL_FONT_ID, badgeX + 4, badgeY + 3, progressStr, true);
-          }
+        int textH = renderer.getTextHeight(SMALL_FONT_ID);
+        int badgeH = textH + 6;
+        int badgeW;
+        if (isComplete) {
+          badgeW = badgeH;  // square for checkmark
+        } else {
+          badgeW = renderer.getTextWidth(SMALL_FONT_ID, progressStr) + 8;
+        }
+        int badgeX = tileX + tileWidth - hPaddingInSelection - badgeW - 2;
+        int badgeY = tileY + hPaddingInSelection + Lyra3CoversMetrics::values.homeCoverHeight - badgeH - 4;
+        renderer.fillRect(badgeX, badgeY, badgeW, badgeH, false);  // white fill
+        renderer.drawRect(badgeX, badgeY, badgeW, badgeH, true);   // black border
+
+        if (isComplete) {
+          // Draw checkmark ✓ using lines
+          int cx = badgeX + badgeW / 2;
+          int cy = badgeY + badgeH / 2;
+          renderer.drawLine(cx - 5, cy, cx - 1, cy + 4, true);
+          renderer.drawLine(cx - 1, cy + 4, cx + 5, cy - 4, true);
+          // Thicken the lines
+          renderer.drawLine(cx - 5, cy + 1, cx - 1, cy + 5, true);
+          renderer.drawLine(cx - 1, cy + 5, cx + 5, cy - 3, true);
+        } else {
+          renderer.drawText(SMALL_FONT_ID, badgeX + 4, badgeY + 3, progressStr, true);
         }
       }
-
-      coverBufferStored = storeCoverBuffer();
-      coverRendered = true;
     }
 
     for (int i = 0; i < std::min(static_cast<int>(recentBooks.size()), Lyra3CoversMetrics::values.homeRecentBooksCount);
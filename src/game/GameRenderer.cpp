@@ -1,5 +1,7 @@
 #include "GameRenderer.h"
 
+#include <Logging.h>
+
 #include <algorithm>
 #include <cstdio>
 
@@ -23,24 +25,72 @@ void GameRenderer::init(GfxRenderer& renderer) {
 
   messageY = viewportEndY;
   hintsY = screenH - HINTS_H;
+  frameValid = false;
+  viewPlaced = false;
+
+  // Every glyph the grid can show, so cells are blitted from the atlas instead of rasterized each turn
+  std::string glyphs = "@";
+  const auto addGlyph = [&glyphs](const char c) {
+    if (c > ' ' && glyphs.find(c) == std::string::npos) glyphs += c;
+  };
+  for (int t = 0; t < static_cast<int>(game::Tile::TileCount); t++) {
+    addGlyph(game::tileGlyph(static_cast<game::Tile>(t)));
+  }
+  for (const auto& def : game::MONSTER_DEFS) addGlyph(def.glyph);
+  for (const auto& def : game::ITEM_DEFS) addGlyph(def.glyph);
+  renderer.buildGlyphAtlas(UI_10_FONT_ID, glyphs.c_str(), cellAtlas);
+
+  // A changed cell is cleared and redrawn on its own, so its glyph must not reach into the cells around it
+  int inkTop, inkBottom;
+  cellAtlas.getInkRows(&inkTop, &inkBottom);
+  glyphOffsetY = std::max(-inkTop, (CELL_H - (inkBottom - inkTop)) / 2 - inkTop);
+  if (inkBottom - inkTop > CELL_H) {
+    LOG_ERR("GAM", "Grid glyphs are %d px tall, cells %d px", inkBottom - inkTop, CELL_H);
+  }
 }
 
 void GameRenderer::draw(GfxRenderer& renderer, const game::Tile* tiles, const uint8_t* fogOfWar,
                         const game::Monster* monsters, uint8_t monsterCount, const game::Item* items, uint8_t itemCount,
-                        const bool* visible) {
-  renderer.clearScreen();
+                        const uint8_t* visible) {
+  const auto& p = GAME_STATE.player;
+  const bool full = !frameValid;
+
+  if (full) {
+    renderer.clearScreen();
+    shownCells.assign(viewCols * viewRows, CELL_UNSEEN);
+    drawHints(renderer);
+
+    // Separator lines
+    renderer.drawLine(0, STATUS_H, screenW, STATUS_H);
+    renderer.drawLine(0, viewportEndY, screenW, viewportEndY);
+    renderer.drawLine(0, hintsY, screenW, hintsY);
+  }
+
+  char status[48];
+  snprintf(status, sizeof(status), "%u/%u %u/%u %u %u", p.hp, p.maxHp, p.mp, p.maxMp, p.dungeonDepth, p.charLevel);
+  if (full || shownStatus != status) {
+    shownStatus = status;
+    renderer.fillRect(0, 0, screenW, STATUS_H, false);
+    drawStatusBar(renderer);
+  }
 
-  drawStatusBar(renderer);
-  drawViewport(renderer, tiles, fogOfWar, monsters, monsterCount, items, itemCount, visible);
-  drawMessages(renderer);
-  drawHints(renderer);
+  buildViewportCells(tiles, fogOfWar, monsters, monsterCount, items, itemCount, visible);
+  drawViewport(renderer, full);
 
-  // Separator lines
-  renderer.drawLine(0, STATUS_H, screenW, STATUS_H);
-  renderer.drawLine(0, viewportEndY, screenW, viewportEndY);
-  renderer.drawLine(0, hintsY, screenW, hintsY);
+  if (full || shownMessages[0] != GAME_STATE.getMessage(0) || shownMessages[1] != GAME_STATE.getMessage(1)) {
+    shownMessages[0] = GAME_STATE.getMessage(0);
+    shownMessages[1] = GAME_STATE.getMessage(1);
+    renderer.fillRect(0, messageY + 1, screenW, hintsY - messageY - 1, false);
+    drawMessages(renderer);
+  }
 
-  renderer.displayBuffer(HalDisplay::FAST_REFRESH);
+  if (full) {
+    renderer.displayBuffer(HalDisplay::FAST_REFRESH);
+    frameValid = true;
+  } else {
+    // Fast refresh of the changed box, with a half refresh once the ghosting debt runs out
+    renderer.displayChanges();
+  }
 }
 
 // --- Status Bar ---
@@ -74,68 +124,86 @@ void GameRenderer::drawStatusBar(GfxRenderer& renderer) const {
 
 // --- Viewport ---
 
-void GameRenderer::drawViewport(GfxRenderer& renderer, const game::Tile* tiles, const uint8_t* fogOfWar,
-                                const game::Monster* monsters, uint8_t monsterCount, const game::Item* items,
-                                uint8_t itemCount, const bool* visible) const {
+// Keeps the viewport where it is until the player comes within SCROLL_MARGIN cells of an edge, then re-centers it
+// on the player, clamped to the map. Moving inside the view then redraws only the cells that changed instead of
+// shifting the whole grid every step.
+void GameRenderer::updateViewOrigin() {
   const auto& p = GAME_STATE.player;
+  const int marginX = std::min(SCROLL_MARGIN, (viewCols - 1) / 2);
+  const int marginY = std::min(SCROLL_MARGIN, (viewRows - 1) / 2);
 
-  // Calculate viewport origin (center on player, clamped to map bounds)
-  int viewX = p.x - viewCols / 2;
-  int viewY = p.y - viewRows / 2;
+  if (!viewPlaced || p.x - viewX < marginX || viewX + viewCols - 1 - p.x < marginX) {
+    viewX = p.x - viewCols / 2;
+  }
+  if (!viewPlaced || p.y - viewY < marginY || viewY + viewRows - 1 - p.y < marginY) {
+    viewY = p.y - viewRows / 2;
+  }
   viewX = std::max(0, std::min(viewX, game::MAP_WIDTH - viewCols));
   viewY = std::max(0, std::min(viewY, game::MAP_HEIGHT - viewRows));
+  viewPlaced = true;
+}
+
+// Works out every viewport cell for this frame. Objects are stamped onto the grid in one pass over the monster
+// and item lists, lowest priority first, instead of searching both lists for each cell.
+void GameRenderer::buildViewportCells(const game::Tile* tiles, const uint8_t* fogOfWar, const game::Monster* monsters,
+                                      uint8_t monsterCount, const game::Item* items, uint8_t itemCount,
+                                      const uint8_t* visible) {
+  const auto& p = GAME_STATE.player;
+  updateViewOrigin();
 
-  // Draw each cell in the viewport
+  frameCells.assign(viewCols * viewRows, CELL_UNSEEN);
   for (int row = 0; row < viewRows; row++) {
     int mapY = viewY + row;
     if (mapY < 0 || mapY >= game::MAP_HEIGHT) continue;
 
-    int screenCellY = VIEWPORT_Y + row * CELL_H;
-
     for (int col = 0; col < viewCols; col++) {
       int mapX = viewX + col;
       if (mapX < 0 || mapX >= game::MAP_WIDTH) continue;
 
-      int mapIdx = mapY * game::MAP_WIDTH + mapX;
-      int screenCellX = gridOffsetX + col * CELL_W;
+      const auto glyph = static_cast<uint8_t>(game::tileGlyph(tiles[mapY * game::MAP_WIDTH + mapX]));
+      if (game::isTileVisible(visible, mapX, mapY)) {
+        frameCells[row * viewCols + col] = CELL_VISIBLE | glyph;
+      } else if (game::fogIsExplored(fogOfWar, mapX, mapY)) {
+        frameCells[row * viewCols + col] = CELL_REMEMBERED | glyph;
+      }
+    }
+  }
+
+  // Objects only show on visible cells. Walk the lists backwards so the first item/monster on a tile wins,
+  // and monsters cover items, as the per-cell search used to.
+  auto stamp = [&](const int mapX, const int mapY, const char glyph) {
+    const int col = mapX - viewX;
+    const int row = mapY - viewY;
+    if (col < 0 || col >= viewCols || row < 0 || row >= viewRows) return;
+    uint16_t& cell = frameCells[row * viewCols + col];
+    if ((cell & 0xFF00) == CELL_VISIBLE) cell = CELL_VISIBLE | static_cast<uint8_t>(glyph);
+  };
+  for (int i = itemCount - 1; i >= 0; i--) {
+    stamp(items[i].x, items[i].y, game::itemGlyph(items[i].type));
+  }
+  for (int m = monsterCount - 1; m >= 0; m--) {
+    if (monsters[m].hp > 0) stamp(monsters[m].x, monsters[m].y, game::MONSTER_DEFS[monsters[m].type].glyph);
+  }
+  stamp(p.x, p.y, '@');
+}
 
-      bool isExplored = game::fogIsExplored(fogOfWar, mapX, mapY);
-      bool isVisible = visible[mapIdx];
+// Redraws the cells that differ from what is on screen (all of them on a full draw)
+void GameRenderer::drawViewport(GfxRenderer& renderer, const bool full) {
+  for (int row = 0; row < viewRows; row++) {
+    int screenCellY = VIEWPORT_Y + row * CELL_H;
 
-      if (!isExplored && !isVisible) {
-        // Unseen tile — leave white (cleared screen)
-        continue;
-      }
+    for (int col = 0; col < viewCols; col++) {
+      const int idx = row * viewCols + col;
+      const uint16_t cell = frameCells[idx];
+      if (!full && cell == shownCells[idx]) continue;
+      shownCells[idx] = cell;
 
-      // Determine what glyph to show
-      char glyph = game::tileGlyph(tiles[mapIdx]);
-
-      // If currently visible, check for monsters and items on this tile
-      if (isVisible) {
-        // Player
-        if (mapX == p.x && mapY == p.y) {
-          glyph = '@';
-        } else {
-          // Check monsters
-          for (uint8_t m = 0; m < monsterCount; m++) {
-            if (monsters[m].x == mapX && monsters[m].y == mapY && monsters[m].hp > 0) {
-              glyph = game::MONSTER_DEFS[monsters[m].type].glyph;
-              break;
-            }
-          }
-          // Check items (only if no monster shown)
-          if (glyph == game::tileGlyph(tiles[mapIdx])) {
-            for (uint8_t i = 0; i < itemCount; i++) {
-              if (items[i].x == mapX && items[i].y == mapY) {
-                glyph = game::itemGlyph(items[i].type);
-                break;
-              }
-            }
-          }
-        }
+      int screenCellX = gridOffsetX + col * CELL_W;
+      if (!full) {
+        renderer.fillRect(screenCellX, screenCellY, CELL_W, CELL_H, false);
       }
-
-      drawCell(renderer, screenCellX, screenCellY, glyph, isVisible, isExplored);
+      drawCell(renderer, screenCellX, screenCellY, static_cast<char>(cell & 0xFF), (cell & 0xFF00) == CELL_VISIBLE,
+               (cell & 0xFF00) == CELL_REMEMBERED);
     }
   }
 }
@@ -146,16 +214,16 @@ void GameRenderer::drawCell(GfxRenderer& renderer, int screenX, int screenY, cha
     // Visible: black character on white background
     char buf[2] = {glyph, '\0'};
     // Center character horizontally in cell
-    int charW = renderer.getTextWidth(UI_10_FONT_ID, buf);
+    int charW = renderer.getAtlasTextWidth(cellAtlas, buf);
     int offsetX = (CELL_W - charW) / 2;
-    renderer.drawText(UI_10_FONT_ID, screenX + offsetX, screenY - 2, buf, true);
+    renderer.drawAtlasText(cellAtlas, screenX + offsetX, screenY + glyphOffsetY, buf, true);
   } else if (isExplored) {
     // Remembered: gray dithered character
     renderer.fillRectDither(screenX, screenY, CELL_W, CELL_H, LightGray);
     char buf[2] = {glyph, '\0'};
-    int charW = renderer.getTextWidth(UI_10_FONT_ID, buf);
+    int charW = renderer.getAtlasTextWidth(cellAtlas, buf);
     int offsetX = (CELL_W - charW) / 2;
-    renderer.drawText(UI_10_FONT_ID, screenX + offsetX, screenY - 2, buf, true);
+    renderer.drawAtlasText(cellAtlas, screenX + offsetX, screenY + glyphOffsetY, buf, true);
   }
 }
 
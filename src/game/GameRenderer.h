@@ -1,13 +1,19 @@
 #pragma once
 
 #include <GfxRenderer.h>
+#include <GlyphAtlas.h>
+
+#include <string>
+#include <vector>
 
 #include "GameTypes.h"
 
 class GameState;
 
 // Renders the dungeon viewport, status bar, message log, and button hints.
-// Stateless — all data passed in or accessed via GameState singleton.
+// Game data is passed in or accessed via GameState singleton. The renderer only remembers what it last put on
+// screen, so a turn redraws the cells and lines that changed, and RefreshPlanner refreshes the box around them with
+// a half refresh whenever the fast refreshes have built up enough ghosting.
 class GameRenderer {
  public:
   // Grid cell dimensions (pixels)
@@ -20,6 +26,8 @@ class GameRenderer {
   static constexpr int VIEWPORT_Y = STATUS_H + 2;
   static constexpr int MESSAGE_H = 38;
   static constexpr int HINTS_H = 34;
+  // The viewport scrolls once the player comes within this many cells of its edge
+  static constexpr int SCROLL_MARGIN = 4;
 
   // Computed at init
   int viewportW = 0;   // Pixels
@@ -32,18 +40,36 @@ class GameRenderer {
   int screenW = 0;
   int screenH = 0;
   int gridOffsetX = 0; // Left padding to center grid
+  int glyphOffsetY = 0; // Text y within a cell that centers the grid glyphs' ink in it
 
   void init(GfxRenderer& renderer);
 
-  // Draw the full game screen
+  // Draw the game screen and refresh the part of it that changed since the last draw
   void draw(GfxRenderer& renderer, const game::Tile* tiles, const uint8_t* fogOfWar, const game::Monster* monsters,
-            uint8_t monsterCount, const game::Item* items, uint8_t itemCount, const bool* visible);
+            uint8_t monsterCount, const game::Item* items, uint8_t itemCount, const uint8_t* visible);
+
+  // Make the next draw repaint and refresh the whole screen, e.g. after another activity drew over it
+  void invalidate() { frameValid = false; }
 
  private:
+  // Viewport cell contents: glyph in the low byte, CellState in the high byte. 0 is an unseen (blank) cell.
+  enum CellState : uint16_t { CELL_UNSEEN = 0, CELL_REMEMBERED = 1 << 8, CELL_VISIBLE = 2 << 8 };
+
+  std::vector<uint16_t> shownCells;  // What is on screen, viewCols * viewRows
+  std::vector<uint16_t> frameCells;  // This frame's cells, indexed the same way
+  std::string shownStatus;
+  std::string shownMessages[2];
+  bool frameValid = false;
+  int viewX = 0;  // Map cell at the viewport's top left
+  int viewY = 0;
+  bool viewPlaced = false;
+  GlyphAtlas cellAtlas;  // Grid glyphs, pre-rasterized at init
+
+  void updateViewOrigin();
+  void buildViewportCells(const game::Tile* tiles, const uint8_t* fogOfWar, const game::Monster* monsters,
+                          uint8_t monsterCount, const game::Item* items, uint8_t itemCount, const uint8_t* visible);
   void drawStatusBar(GfxRenderer& renderer) const;
-  void drawViewport(GfxRenderer& renderer, const game::Tile* tiles, const uint8_t* fogOfWar,
-                    const game::Monster* monsters, uint8_t monsterCount, const game::Item* items, uint8_t itemCount,
-                    const bool* visible) const;
+  void drawViewport(GfxRenderer& renderer, bool full);
   void drawCell(GfxRenderer& renderer, int screenX, int screenY, char glyph, bool isVisible, bool isExplored) const;
   void drawMessages(GfxRenderer& renderer) const;
   void drawHints(GfxRenderer& renderer) const;
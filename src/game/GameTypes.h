@@ -220,6 +220,11 @@ inline void fogSetExplored(uint8_t* fog, int x, int y) {
   fog[idx / 8] |= (1 << (idx % 8));
 }
 
+// The per-turn visibility set uses the same bitfield layout (FOG_SIZE bytes)
+inline bool isTileVisible(const uint8_t* visible, int x, int y) { return fogIsExplored(visible, x, y); }
+
+inline void setTileVisible(uint8_t* visible, int x, int y) { fogSetExplored(visible, x, y); }
+
 // --- XorShift32 RNG (deterministic, 4 bytes state) ---
 
 struct Rng {
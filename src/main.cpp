@@ -8,6 +8,8 @@
 #include <HalStorage.h>
 #include <I18n.h>
 #include <Logging.h>
+#include <MemoryBudget.h>
+#include <PerfTrace.h>
 #include <SPI.h>
 #include <builtinFonts/all.h>
 
@@ -18,6 +20,7 @@
 #include "KOReaderCredentialStore.h"
 #include "MappedInputManager.h"
 #include "RecentBooksStore.h"
+#include "ResumeSnapshot.h"
 #include "activities/boot_sleep/BootActivity.h"
 #include "activities/boot_sleep/SleepActivity.h"
 #include "activities/browser/OpdsBookBrowserActivity.h"
@@ -206,12 +209,19 @@ void waitForPowerRelease() {
 void enterDeepSleep() {
   APP_STATE.lastSleepFromReader = currentActivity && currentActivity->isReaderActivity();
   APP_STATE.saveToFile();
+  // Before the sleep screen replaces the page in the framebuffer
+  if (APP_STATE.lastSleepFromReader) {
+    RESUME_SNAPSHOT.saveToFile(renderer);
+  } else {
+    ResumeSnapshot::removeFile();
+  }
   exitActivity();
   enterNewActivity(new SleepActivity(renderer, mappedInputManager));
 
   display.deepSleep();
   LOG_DBG("MAIN", "Power button press calibration value: %lu ms", t2 - t1);
   LOG_DBG("MAIN", "Entering deep sleep");
+  logFlush();
 
   powerManager.startDeepSleep(gpio);
 }
@@ -376,16 +386,26 @@ void setup() {
 
   setupDisplayAndFonts();
 
-  exitActivity();
-  enterNewActivity(new BootActivity(renderer, mappedInputManager));
-
   APP_STATE.loadFromFile();
   RECENT_BOOKS.loadFromFile();
 
   // Boot to home screen if no book is open, last sleep was not from reader, back button is held, or reader activity
   // crashed (indicated by readerActivityLoadCount > 0)
-  if (APP_STATE.openEpubPath.empty() || !APP_STATE.lastSleepFromReader ||
-      mappedInputManager.isPressed(MappedInputManager::Button::Back) || APP_STATE.readerActivityLoadCount > 0) {
+  const bool bootToHome = APP_STATE.openEpubPath.empty() || !APP_STATE.lastSleepFromReader ||
+                          mappedInputManager.isPressed(MappedInputManager::Button::Back) ||
+                          APP_STATE.readerActivityLoadCount > 0;
+
+  // When resuming, put the page back on screen right away instead of the boot screen; the reader loads the book
+  // behind it and renders the same page again
+  if (bootToHome) {
+    ResumeSnapshot::removeFile();
+  }
+  if (bootToHome || !RESUME_SNAPSHOT.showFromFile(APP_STATE.openEpubPath, renderer)) {
+    exitActivity();
+    enterNewActivity(new BootActivity(renderer, mappedInputManager));
+  }
+
+  if (bootToHome) {
     onGoHome();
   } else {
     // Clear app state to avoid getting into a boot loop if the epub doesn't load
@@ -412,6 +432,7 @@ void loop() {
   if (Serial && millis() - lastMemPrint >= 10000) {
     LOG_INF("MEM", "Free: %d bytes, Total: %d bytes, Min Free: %d bytes", ESP.getFreeHeap(), ESP.getHeapSize(),
             ESP.getMinFreeHeap());
+    MemBudget.logUsage();
     lastMemPrint = millis();
   }
 
@@ -423,10 +444,14 @@ void loop() {
       String cmd = line.substring(4);
       cmd.trim();
       if (cmd == "SCREENSHOT") {
+        LogSerialLock lock;
         logSerial.printf("SCREENSHOT_START:%d\n", HalDisplay::BUFFER_SIZE);
         uint8_t* buf = display.getFrameBuffer();
         logSerial.write(buf, HalDisplay::BUFFER_SIZE);
         logSerial.printf("SCREENSHOT_END\n");
+      } else if (cmd == "STATS") {
+        LogSerialLock lock;
+        perf::printStats(logSerial);
       }
     }
   }
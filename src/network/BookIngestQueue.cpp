@@ -0,0 +1,169 @@
+#include "BookIngestQueue.h"
+
+#include <Arduino.h>
+#include <Epub.h>
+#include <Logging.h>
+#include <Xtc.h>
+
+#include <algorithm>
+
+#include "CrossPointSettings.h"
+#include "components/UITheme.h"
+#include "util/StringUtils.h"
+
+namespace {
+bool isEpub(const std::string& path) { return StringUtils::checkFileExtension(path, ".epub"); }
+
+bool isXtc(const std::string& path) {
+  return StringUtils::checkFileExtension(path, ".xtc") || StringUtils::checkFileExtension(path, ".xtch");
+}
+}  // namespace
+
+void BookIngestQueue::enqueue(const std::string& path) {
+  if (!isEpub(path) && !isXtc(path)) {
+    return;
+  }
+
+  remove(path);
+  if (entries.size() >= MAX_ENTRIES) {
+    // Make room by dropping the oldest finished book, or the oldest pending one when none has finished. A dropped
+    // book is simply prepared on its first open instead.
+    auto victim = std::find_if(entries.begin(), entries.end(), [](const Entry& e) {
+      return e.state == State::DONE || e.state == State::FAILED;
+    });
+    if (victim == entries.end()) {
+      victim = entries.begin();
+      LOG_DBG("ING", "Queue full, dropping: %s", victim->path.c_str());
+    }
+    const std::string dropped = victim->path;
+    remove(dropped);
+  }
+
+  entries.push_back(Entry{path});
+  LOG_DBG("ING", "Queued for ingestion: %s", path.c_str());
+}
+
+void BookIngestQueue::remove(const std::string& path) {
+  if (indexingEpub && indexingEpub->getPath() == path) {
+    indexingEpub.reset();
+  }
+  entries.erase(std::remove_if(entries.begin(), entries.end(), [&path](const Entry& e) { return e.path == path; }),
+                entries.end());
+}
+
+void BookIngestQueue::clear() {
+  entries.clear();
+  indexingEpub.reset();
+}
+
+bool BookIngestQueue::hasPending() const {
+  return std::any_of(entries.begin(), entries.end(),
+                     [](const Entry& e) { return e.state != State::DONE && e.state != State::FAILED; });
+}
+
+bool BookIngestQueue::processNext() {
+  const auto it = std::find_if(entries.begin(), entries.end(),
+                               [](const Entry& e) { return e.state != State::DONE && e.state != State::FAILED; });
+  if (it == entries.end()) {
+    return false;
+  }
+
+  const unsigned long start = millis();
+  it->state = runStep(*it);
+  it->elapsedMs += millis() - start;
+
+  if (it->state == State::DONE || it->state == State::FAILED) {
+    LOG_DBG("ING", "Ingestion %s after %lu ms: %s", stateName(it->state), it->elapsedMs, it->path.c_str());
+  }
+  return true;
+}
+
+BookIngestQueue::State BookIngestQueue::runStep(const Entry& entry) {
+  const bool cropped = SETTINGS.sleepScreenCoverMode == CrossPointSettings::SLEEP_SCREEN_COVER_MODE::CROP;
+  const int thumbHeight = UITheme::getInstance().getMetrics().homeCoverHeight;
+
+  if (isEpub(entry.path)) {
+    if (entry.state == State::QUEUED || entry.state == State::INDEXING) {
+      // book.bin is built one pass per step, the Epub keeps the build state in between
+      if (!indexingEpub || indexingEpub->getPath() != entry.path) {
+        indexingEpub.reset(new Epub(entry.path, "/.crosspoint"));
+        if (indexingEpub->load(false, true)) {
+          indexingEpub.reset();
+          return State::METADATA;
+        }
+      }
+      bool indexed = false;
+      if (!indexingEpub->buildCacheStep(indexed)) {
+        indexingEpub.reset();
+        return State::FAILED;
+      }
+      if (!indexed) {
+        return State::INDEXING;
+      }
+      indexingEpub.reset();
+      return State::METADATA;
+    }
+
+    Epub epub(entry.path, "/.crosspoint");
+    switch (entry.state) {
+      case State::METADATA:
+        // Builds the CSS rules cache
+        return epub.load(false, false) ? State::STYLES : State::FAILED;
+      case State::STYLES:
+        if (!epub.load(false, true)) {
+          return State::FAILED;
+        }
+        if (!epub.generateCoverBmp(cropped)) {
+          LOG_DBG("ING", "No cover generated for %s", entry.path.c_str());
+        }
+        return State::COVER;
+      case State::COVER:
+        if (!epub.load(false, true)) {
+          return State::FAILED;
+        }
+        epub.generateThumbBmp(thumbHeight);
+        return State::DONE;
+      default:
+        return entry.state;
+    }
+  }
+
+  Xtc xtc(entry.path, "/.crosspoint");
+  if (!xtc.load()) {
+    return State::FAILED;
+  }
+  switch (entry.state) {
+    case State::QUEUED:
+      return State::METADATA;
+    case State::METADATA:
+      if (!xtc.generateCoverBmp()) {
+        LOG_DBG("ING", "No cover generated for %s", entry.path.c_str());
+      }
+      return State::COVER;
+    case State::COVER:
+      xtc.generateThumbBmp(thumbHeight);
+      return State::DONE;
+    default:
+      return entry.state;
+  }
+}
+
+const char* BookIngestQueue::stateName(const State state) {
+  switch (state) {
+    case State::QUEUED:
+      return "queued";
+    case State::INDEXING:
+      return "indexing";
+    case State::METADATA:
+      return "metadata";
+    case State::STYLES:
+      return "styles";
+    case State::COVER:
+      return "cover";
+    case State::DONE:
+      return "done";
+    case State::FAILED:
+      return "failed";
+  }
+  return "unknown";
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Epub;
+
+/**
+ * Post-upload book preprocessing for the web server.
+ *
+ * Books received over HTTP or WebSocket are queued and ingested while the server is otherwise idle, when Wi-Fi
+ * keeps the CPU at full speed anyway: the metadata and CSS caches, the sleep cover and the home thumbnail are
+ * built so the first open on the device does not pay for them. Ingestion is split into steps so the server keeps
+ * serving requests between them; the EPUB index is built one pass per step.
+ */
+class BookIngestQueue {
+ public:
+  // Last completed step of a book
+  enum class State : uint8_t { QUEUED, INDEXING, METADATA, STYLES, COVER, DONE, FAILED };
+
+  struct Entry {
+    std::string path;
+    State state = State::QUEUED;
+    unsigned long elapsedMs = 0;  // Time spent ingesting so far
+  };
+
+  // Queue a book for ingestion. Unsupported file types are ignored.
+  void enqueue(const std::string& path);
+  // Forget a book, e.g. after it was deleted or renamed
+  void remove(const std::string& path);
+  // Run the next ingestion step. Returns false if there was nothing to do.
+  bool processNext();
+  bool hasPending() const;
+  void clear();
+
+  const std::vector<Entry>& getEntries() const { return entries; }
+  static const char* stateName(State state);
+
+ private:
+  static constexpr size_t MAX_ENTRIES = 16;
+  std::vector<Entry> entries;
+  // EPUB whose spine/TOC cache is being built, kept across the INDEXING steps
+  std::unique_ptr<Epub> indexingEpub;
+
+  State runStep(const Entry& entry);
+};
@@ -5,11 +5,14 @@
 #include <FsHelpers.h>
 #include <HalStorage.h>
 #include <Logging.h>
+#include <PerfTrace.h>
 #include <WiFi.h>
 #include <esp_task_wdt.h>
 
 #include <algorithm>
+#include <vector>
 
+#include "BookIngestQueue.h"
 #include "CrossPointSettings.h"
 #include "SettingsList.h"
 #include "html/FilesPageHtml.generated.h"
@@ -24,6 +27,13 @@ const char* HIDDEN_ITEMS[] = {"System Volume Information", "XTCache"};
 constexpr size_t HIDDEN_ITEMS_COUNT = sizeof(HIDDEN_ITEMS) / sizeof(HIDDEN_ITEMS[0]);
 constexpr uint16_t UDP_PORTS[] = {54982, 48123, 39001, 44044, 59678};
 constexpr uint16_t LOCAL_UDP_PORT = 8134;
+// Quiet period after the last upload data before ingestion steps run, so batch uploads are not slowed down
+constexpr unsigned long INGEST_IDLE_MS = 1500;
+// Resumable uploads flush to the card and acknowledge after this much data or this long, whichever comes first
+constexpr size_t WS_ACK_BYTES = 32768;
+constexpr unsigned long WS_ACK_INTERVAL_MS = 1000;
+// Longest upload id a client may pick; ids name the partial file, so they are limited to letters and digits
+constexpr size_t WS_UPLOAD_ID_MAX = 32;
 
 // Static pointer for WebSocket callback (WebSocketsServer requires C-style callback)
 CrossPointWebServer* wsInstance = nullptr;
@@ -36,10 +46,127 @@ size_t wsUploadSize = 0;
 size_t wsUploadReceived = 0;
 unsigned long wsUploadStartTime = 0;
 bool wsUploadInProgress = false;
+// Id the client picked for this upload, empty for plain START sessions. It names the partial file, so a RESUME
+// only ever continues bytes of the same upload.
+String wsUploadId;
+// Session with an upload id: the partial file survives a disconnect so the client can continue from its size
+bool wsUploadResumable = false;
+// Partial kept from a dropped session, deleted once another upload starts instead of resuming it
+String wsKeptPartPath;
+size_t wsLastProgressSent = 0;
+size_t wsLastAckSent = 0;
+unsigned long wsLastAckAt = 0;
 String wsLastCompleteName;
 size_t wsLastCompleteSize = 0;
 unsigned long wsLastCompleteAt = 0;
 
+// Books waiting for post-upload preprocessing
+BookIngestQueue ingestQueue;
+unsigned long lastTransferActivity = 0;
+
+String wsUploadTargetPath() {
+  String filePath = wsUploadPath;
+  if (!filePath.endsWith("/")) filePath += "/";
+  return filePath + wsUploadFileName;
+}
+
+// Data is received into a hidden sibling and only takes the real name once complete, so an interrupted transfer
+// never leaves a truncated book in the library
+String wsUploadPartPath() {
+  String filePath = wsUploadPath;
+  if (!filePath.endsWith("/")) filePath += "/";
+  if (wsUploadId.isEmpty()) return filePath + "." + wsUploadFileName + ".part";
+  return filePath + "." + wsUploadFileName + "." + wsUploadId + ".part";
+}
+
+bool isValidUploadId(const String& id) {
+  if (id.isEmpty() || id.length() > WS_UPLOAD_ID_MAX) return false;
+  for (size_t i = 0; i < id.length(); i++) {
+    if (!isalnum(static_cast<unsigned char>(id[i]))) return false;
+  }
+  return true;
+}
+
+// Delete the partials other uploads of the current file left in its folder. Their ids are gone with the page
+// that picked them, so nothing can resume them anymore.
+void removeStaleWsPartials(const String& keepPath) {
+  FsFile dir = Storage.open(wsUploadPath.c_str());
+  if (!dir || !dir.isDirectory()) {
+    if (dir) dir.close();
+    return;
+  }
+
+  String folder = wsUploadPath;
+  if (!folder.endsWith("/")) folder += "/";
+  const String prefix = "." + wsUploadFileName + ".";
+  std::vector<String> stale;
+  char name[500];
+  for (FsFile entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+    entry.getName(name, sizeof(name));
+    const bool isDirectory = entry.isDirectory();
+    entry.close();
+    esp_task_wdt_reset();
+
+    // ".<file>.part" or ".<file>.<id>.part", matched exactly so partials of longer names are left alone
+    const String entryName(name);
+    if (isDirectory || !entryName.startsWith(prefix)) continue;
+    const String rest = entryName.substring(prefix.length());
+    if (rest == "part" || (rest.endsWith(".part") && isValidUploadId(rest.substring(0, rest.length() - 5)))) {
+      stale.push_back(folder + entryName);
+    }
+  }
+  dir.close();
+
+  for (const auto& path : stale) {
+    if (path == keepPath) continue;
+    Storage.remove(path.c_str());
+    LOG_DBG("WS", "Deleted stale partial upload: %s", path.c_str());
+  }
+}
+
+enum class ByteRange { NONE, SATISFIABLE, UNSATISFIABLE };
+
+// Parse a single "bytes=" range (RFC 9110) against a file size. Malformed and multi-range headers are ignored so
+// the whole file is served instead.
+ByteRange parseByteRange(const String& header, const size_t size, size_t& first, size_t& last) {
+  if (!header.startsWith("bytes=") || header.indexOf(',') >= 0) {
+    return ByteRange::NONE;
+  }
+  const int dash = header.indexOf('-', 6);
+  if (dash < 0) {
+    return ByteRange::NONE;
+  }
+  const String firstStr = header.substring(6, dash);
+  const String lastStr = header.substring(dash + 1);
+  if (firstStr.isEmpty() && lastStr.isEmpty()) {
+    return ByteRange::NONE;
+  }
+
+  if (firstStr.isEmpty()) {
+    // Suffix range: the final N bytes
+    const size_t suffix = strtoul(lastStr.c_str(), nullptr, 10);
+    if (suffix == 0 || size == 0) {
+      return ByteRange::UNSATISFIABLE;
+    }
+    first = suffix >= size ? 0 : size - suffix;
+    last = size - 1;
+    return ByteRange::SATISFIABLE;
+  }
+
+  first = strtoul(firstStr.c_str(), nullptr, 10);
+  last = lastStr.isEmpty() ? size - 1 : strtoul(lastStr.c_str(), nullptr, 10);
+  if (first >= size) {
+    return ByteRange::UNSATISFIABLE;
+  }
+  if (last < first) {
+    return ByteRange::NONE;
+  }
+  if (last >= size) {
+    last = size - 1;
+  }
+  return ByteRange::SATISFIABLE;
+}
+
 // Helper function to clear epub cache after upload
 void clearEpubCacheIfNeeded(const String& filePath) {
   // Only clear cache for .epub files
@@ -133,6 +260,7 @@ void CrossPointWebServer::begin() {
   server->on("/files", HTTP_GET, [this] { handleFileList(); });
 
   server->on("/api/status", HTTP_GET, [this] { handleStatus(); });
+  server->on("/api/perf", HTTP_GET, [this] { handlePerf(); });
   server->on("/api/files", HTTP_GET, [this] { handleFileListData(); });
   server->on("/download", HTTP_GET, [this] { handleDownload(); });
 
@@ -157,6 +285,10 @@ void CrossPointWebServer::begin() {
   server->on("/api/settings", HTTP_POST, [this] { handlePostSettings(); });
 
   server->onNotFound([this] { handleNotFound(); });
+
+  // Request headers are dropped unless asked for; /download needs Range
+  const char* collectedHeaders[] = {"Range"};
+  server->collectHeaders(collectedHeaders, 1);
   LOG_DBG("WEB", "[MEM] Free heap after route setup: %d bytes", ESP.getFreeHeap());
 
   server->begin();
@@ -193,11 +325,17 @@ void CrossPointWebServer::stop() {
 
   LOG_DBG("WEB", "[MEM] Free heap before stop: %d bytes", ESP.getFreeHeap());
 
-  // Close any in-progress WebSocket upload
+  // Close any in-progress WebSocket upload. No client can resume it once the server is gone, so its partial file
+  // is deleted along with one kept from an earlier dropped session.
   if (wsUploadInProgress && wsUploadFile) {
     wsUploadFile.close();
+    Storage.remove(wsUploadPartPath().c_str());
     wsUploadInProgress = false;
   }
+  if (!wsKeptPartPath.isEmpty()) {
+    Storage.remove(wsKeptPartPath.c_str());
+    wsKeptPartPath = "";
+  }
 
   // Stop WebSocket server
   if (wsServer) {
@@ -213,6 +351,9 @@ void CrossPointWebServer::stop() {
     udpActive = false;
   }
 
+  // Books still queued are preprocessed on first open instead
+  ingestQueue.clear();
+
   // Brief delay to allow any in-flight handleClient() calls to complete
   delay(20);
 
@@ -279,6 +420,14 @@ void CrossPointWebServer::handleClient() {
       }
     }
   }
+
+  // Preprocess uploaded books once transfers have gone quiet
+  if (!wsUploadInProgress && !upload.file && ingestQueue.hasPending() &&
+      millis() - lastTransferActivity > INGEST_IDLE_MS) {
+    esp_task_wdt_reset();
+    ingestQueue.processNext();
+    esp_task_wdt_reset();
+  }
 }
 
 CrossPointWebServer::WsUploadStatus CrossPointWebServer::getWsUploadStatus() const {
@@ -321,6 +470,41 @@ void CrossPointWebServer::handleStatus() const {
   doc["freeHeap"] = ESP.getFreeHeap();
   doc["uptime"] = millis() / 1000;
 
+  JsonArray ingest = doc["ingest"].to<JsonArray>();
+  for (const auto& entry : ingestQueue.getEntries()) {
+    JsonObject book = ingest.add<JsonObject>();
+    book["path"] = entry.path;
+    book["state"] = BookIngestQueue::stateName(entry.state);
+    book["elapsedMs"] = entry.elapsedMs;
+  }
+
+  String json;
+  serializeJson(doc, json);
+  server->send(200, "application/json", json);
+}
+
+void CrossPointWebServer::handlePerf() const {
+  JsonDocument doc;
+  doc["enabled"] = perf::enabled;
+
+  JsonArray metrics = doc["metrics"].to<JsonArray>();
+  for (size_t i = 0; perf::enabled && i < static_cast<size_t>(perf::Metric::COUNT); i++) {
+    const auto metric = static_cast<perf::Metric>(i);
+    const perf::Stats stats = perf::getStats(metric);
+    JsonObject entry = metrics.add<JsonObject>();
+    entry["name"] = perf::metricName(metric);
+    entry["count"] = stats.count;
+    entry["minUs"] = stats.minMicros;
+    entry["avgUs"] = stats.avgMicros;
+    entry["maxUs"] = stats.maxMicros;
+  }
+
+  JsonObject counters = doc["counters"].to<JsonObject>();
+  for (size_t i = 0; perf::enabled && i < static_cast<size_t>(perf::Counter::COUNT); i++) {
+    const auto counter = static_cast<perf::Counter>(i);
+    counters[perf::counterName(counter)] = perf::getCounter(counter);
+  }
+
   String json;
   serializeJson(doc, json);
   server->send(200, "application/json", json);
@@ -498,13 +682,51 @@ void CrossPointWebServer::handleDownload() const {
     filename = nameBuf;
   }
 
-  server->setContentLength(file.size());
-  server->sendHeader("Content-Disposition", "attachment; filename=\"" + filename + "\"");
-  server->send(200, contentType.c_str(), "");
+  const size_t fileSize = file.size();
+  size_t first = 0;
+  size_t last = fileSize == 0 ? 0 : fileSize - 1;
+  const ByteRange range = parseByteRange(server->header("Range"), fileSize, first, last);
+  if (range == ByteRange::UNSATISFIABLE) {
+    file.close();
+    server->sendHeader("Content-Range", "bytes */" + String(fileSize));
+    server->send(416, "text/plain", "Range not satisfiable");
+    return;
+  }
 
+  server->sendHeader("Accept-Ranges", "bytes");
+  server->sendHeader("Content-Disposition", "attachment; filename=\"" + filename + "\"");
   WiFiClient client = server->client();
-  client.write(file);
+
+  if (range == ByteRange::NONE) {
+    server->setContentLength(fileSize);
+    server->send(200, contentType.c_str(), "");
+    client.write(file);
+    file.close();
+    return;
+  }
+
+  const size_t length = last - first + 1;
+  if (!file.seekSet(first)) {
+    file.close();
+    server->send(500, "text/plain", "Failed to seek file");
+    return;
+  }
+  server->sendHeader("Content-Range", "bytes " + String(first) + "-" + String(last) + "/" + String(fileSize));
+  server->setContentLength(length);
+  server->send(206, contentType.c_str(), "");
+
+  // client.write(file) streams to end of file, so bounded ranges are copied by hand
+  uint8_t buffer[1024];
+  size_t remaining = length;
+  while (remaining > 0 && client.connected()) {
+    const int read = file.read(buffer, std::min(remaining, sizeof(buffer)));
+    if (read <= 0 || client.write(buffer, read) != static_cast<size_t>(read)) {
+      break;
+    }
+    remaining -= read;
+  }
   file.close();
+  LOG_DBG("WEB", "Served range %u-%u/%u of %s", first, last, fileSize, itemPath.c_str());
 }
 
 // Diagnostic counters for upload performance analysis
@@ -558,6 +780,7 @@ void CrossPointWebServer::handleUpload(UploadState& state) const {
     state.bufferPos = 0;
     totalWriteTime = 0;
     writeCount = 0;
+    lastTransferActivity = millis();
 
     // Get upload path from query parameter (defaults to root if not specified)
     // Note: We use query parameter instead of form data because multipart form
@@ -629,6 +852,7 @@ void CrossPointWebServer::handleUpload(UploadState& state) const {
       }
 
       state.size += upload.currentSize;
+      lastTransferActivity = millis();
 
       // Log progress every 100KB
       if (state.size - lastLoggedSize >= 102400) {
@@ -662,6 +886,7 @@ void CrossPointWebServer::handleUpload(UploadState& state) const {
         if (!filePath.endsWith("/")) filePath += "/";
         filePath += state.fileName;
         clearEpubCacheIfNeeded(filePath);
+        ingestQueue.enqueue(filePath.c_str());
       }
     }
   } else if (upload.status == UPLOAD_FILE_ABORTED) {
@@ -813,6 +1038,8 @@ void CrossPointWebServer::handleRename() const {
 
   if (success) {
     LOG_DBG("WEB", "Renamed file: %s -> %s", itemPath.c_str(), newPath.c_str());
+    ingestQueue.remove(itemPath.c_str());
+    ingestQueue.enqueue(newPath.c_str());
     server->send(200, "text/plain", "Renamed successfully");
   } else {
     LOG_ERR("WEB", "Failed to rename file: %s -> %s", itemPath.c_str(), newPath.c_str());
@@ -906,6 +1133,8 @@ void CrossPointWebServer::handleMove() const {
 
   if (success) {
     LOG_DBG("WEB", "Moved file: %s -> %s", itemPath.c_str(), newPath.c_str());
+    ingestQueue.remove(itemPath.c_str());
+    ingestQueue.enqueue(newPath.c_str());
     server->send(200, "text/plain", "Moved successfully");
   } else {
     LOG_ERR("WEB", "Failed to move file: %s -> %s", itemPath.c_str(), newPath.c_str());
@@ -988,6 +1217,7 @@ void CrossPointWebServer::handleDelete() const {
 
   if (success) {
     LOG_DBG("WEB", "Successfully deleted: %s", itemPath.c_str());
+    ingestQueue.remove(itemPath.c_str());
     server->send(200, "text/plain", "Deleted successfully");
   } else {
     LOG_ERR("WEB", "Failed to delete: %s", itemPath.c_str());
@@ -1157,6 +1387,43 @@ void CrossPointWebServer::handlePostSettings() {
   server->send(200, "text/plain", String("Applied ") + String(applied) + " setting(s)");
 }
 
+// Move a fully received WebSocket upload into place
+void CrossPointWebServer::finishWsUpload(const uint8_t num) {
+  wsUploadInProgress = false;
+  wsLastProgressSent = 0;
+
+  const String filePath = wsUploadTargetPath();
+  esp_task_wdt_reset();
+  if (Storage.exists(filePath.c_str())) {
+    Storage.remove(filePath.c_str());
+  }
+  const bool renamed = wsUploadFile.rename(filePath.c_str());
+  wsUploadFile.close();
+  esp_task_wdt_reset();
+  if (!renamed) {
+    LOG_ERR("WS", "Failed to move upload into place: %s", filePath.c_str());
+    Storage.remove(wsUploadPartPath().c_str());
+    wsServer->sendTXT(num, "ERROR:Failed to save file");
+    return;
+  }
+
+  wsLastCompleteName = wsUploadFileName;
+  wsLastCompleteSize = wsUploadSize;
+  wsLastCompleteAt = millis();
+
+  unsigned long elapsed = millis() - wsUploadStartTime;
+  float kbps = (elapsed > 0) ? (wsUploadSize / 1024.0) / (elapsed / 1000.0) : 0;
+
+  LOG_DBG("WS", "Upload complete: %s (%d bytes in %lu ms, %.1f KB/s)", wsUploadFileName.c_str(), wsUploadSize,
+          elapsed, kbps);
+
+  // Clear epub cache to prevent stale metadata issues when overwriting files
+  clearEpubCacheIfNeeded(filePath);
+  ingestQueue.enqueue(filePath.c_str());
+
+  wsServer->sendTXT(num, "DONE");
+}
+
 // WebSocket callback trampoline
 void CrossPointWebServer::wsEventCallback(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
   if (wsInstance) {
@@ -1166,9 +1433,13 @@ void CrossPointWebServer::wsEventCallback(uint8_t num, WStype_t type, uint8_t* p
 
 // WebSocket event handler for fast binary uploads
 // Protocol:
-//   1. Client sends TEXT message: "START:<filename>:<size>:<path>"
-//   2. Client sends BINARY messages with file data chunks
-//   3. Server sends TEXT "PROGRESS:<received>:<total>" after each chunk
+//   1. Client sends TEXT message: "START:<filename>:<size>:<path>" for a plain upload,
+//      "START:<filename>:<size>:<id>:<path>" for a resumable one (server replies "READY"),
+//      or "RESUME:<filename>:<size>:<id>:<path>" after a reconnect (server replies "READY:<offset>", the bytes it
+//      already holds of upload <id>)
+//   2. Client sends BINARY messages with file data chunks, from the offset on when resuming
+//   3. Server sends TEXT "PROGRESS:<received>:<total>" every 64KB, and "ACK:<received>" every 32KB or second of a
+//      resumable session once the data is flushed to the SD card
 //   4. Server sends TEXT "DONE" or "ERROR:<message>" when complete
 void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
   switch (type) {
@@ -1177,12 +1448,15 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
       // Clean up any in-progress upload
       if (wsUploadInProgress && wsUploadFile) {
         wsUploadFile.close();
-        // Delete incomplete file
-        String filePath = wsUploadPath;
-        if (!filePath.endsWith("/")) filePath += "/";
-        filePath += wsUploadFileName;
-        Storage.remove(filePath.c_str());
-        LOG_DBG("WS", "Deleted incomplete upload: %s", filePath.c_str());
+        if (wsUploadResumable) {
+          wsKeptPartPath = wsUploadPartPath();
+          LOG_DBG("WS", "Kept partial upload at %d bytes: %s", wsUploadReceived, wsKeptPartPath.c_str());
+        } else {
+          // Delete incomplete file
+          const String partPath = wsUploadPartPath();
+          Storage.remove(partPath.c_str());
+          LOG_DBG("WS", "Deleted incomplete upload: %s", partPath.c_str());
+        }
       }
       wsUploadInProgress = false;
       break;
@@ -1197,17 +1471,36 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
       String msg = String((char*)payload);
       LOG_DBG("WS", "Text from client %u: %s", num, msg.c_str());
 
-      if (msg.startsWith("START:")) {
-        // Parse: START:<filename>:<size>:<path>
-        int firstColon = msg.indexOf(':', 6);
+      const bool resume = msg.startsWith("RESUME:");
+      if (resume || msg.startsWith("START:")) {
+        // Parse: START:<filename>:<size>[:<id>]:<path> or RESUME:<filename>:<size>:<id>:<path>
+        // FAT names cannot hold ':', so a third colon can only end an upload id
+        const int nameStart = msg.indexOf(':') + 1;
+        int firstColon = msg.indexOf(':', nameStart);
         int secondColon = msg.indexOf(':', firstColon + 1);
+        int idColon = secondColon > 0 ? msg.indexOf(':', secondColon + 1) : -1;
 
         if (firstColon > 0 && secondColon > 0) {
-          wsUploadFileName = msg.substring(6, firstColon);
+          const String uploadId = idColon > 0 ? msg.substring(secondColon + 1, idColon) : String();
+          if ((resume || idColon > 0) && !isValidUploadId(uploadId)) {
+            wsServer->sendTXT(num, "ERROR:Invalid upload id");
+            return;
+          }
+
+          // A new session replaces one that was never finished on this connection, its partial is cleaned up below
+          if (wsUploadInProgress && wsUploadFile) {
+            wsUploadFile.close();
+            wsKeptPartPath = wsUploadPartPath();
+          }
+
+          wsUploadFileName = msg.substring(nameStart, firstColon);
           wsUploadSize = msg.substring(firstColon + 1, secondColon).toInt();
-          wsUploadPath = msg.substring(secondColon + 1);
+          wsUploadPath = msg.substring((idColon > 0 ? idColon : secondColon) + 1);
+          wsUploadId = uploadId;
           wsUploadReceived = 0;
+          wsUploadResumable = !uploadId.isEmpty();
           wsUploadStartTime = millis();
+          lastTransferActivity = wsUploadStartTime;
 
           // Ensure path is valid
           if (!wsUploadPath.startsWith("/")) wsUploadPath = "/" + wsUploadPath;
@@ -1215,23 +1508,34 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
             wsUploadPath = wsUploadPath.substring(0, wsUploadPath.length() - 1);
           }
 
-          // Build file path
-          String filePath = wsUploadPath;
-          if (!filePath.endsWith("/")) filePath += "/";
-          filePath += wsUploadFileName;
+          const String partPath = wsUploadPartPath();
 
-          LOG_DBG("WS", "Starting upload: %s (%d bytes) to %s", wsUploadFileName.c_str(), wsUploadSize,
-                  filePath.c_str());
+          // Partials no session resumed would otherwise stay on the card; only the one a RESUME continues is kept
+          esp_task_wdt_reset();
+          if (!wsKeptPartPath.isEmpty() && wsKeptPartPath != partPath) {
+            Storage.remove(wsKeptPartPath.c_str());
+          }
+          wsKeptPartPath = "";
+          removeStaleWsPartials(resume ? partPath : String());
 
-          // Check if file exists and remove it
+          // Pick up where an earlier session of the same upload left off. A partial larger than the announced size
+          // cannot belong to it and is discarded.
           esp_task_wdt_reset();
-          if (Storage.exists(filePath.c_str())) {
-            Storage.remove(filePath.c_str());
+          if (resume && Storage.exists(partPath.c_str())) {
+            wsUploadFile = Storage.open(partPath.c_str(), O_RDWR);
+            if (wsUploadFile && wsUploadFile.size() <= wsUploadSize && wsUploadFile.seekSet(wsUploadFile.size())) {
+              wsUploadReceived = wsUploadFile.size();
+            } else if (wsUploadFile) {
+              wsUploadFile.close();
+            }
           }
 
-          // Open file for writing
+          LOG_DBG("WS", "%s upload: %s (%d bytes, %d present) to %s", resume ? "Resuming" : "Starting",
+                  wsUploadFileName.c_str(), wsUploadSize, wsUploadReceived, partPath.c_str());
+
+          // Open file for writing, truncating any stale partial
           esp_task_wdt_reset();
-          if (!Storage.openFileForWrite("WS", filePath, wsUploadFile)) {
+          if (!wsUploadFile && !Storage.openFileForWrite("WS", partPath, wsUploadFile)) {
             wsServer->sendTXT(num, "ERROR:Failed to create file");
             wsUploadInProgress = false;
             return;
@@ -1239,7 +1543,20 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
           esp_task_wdt_reset();
 
           wsUploadInProgress = true;
-          wsServer->sendTXT(num, "READY");
+          wsLastProgressSent = wsUploadReceived;
+          wsLastAckSent = wsUploadReceived;
+          wsLastAckAt = wsUploadStartTime;
+          if (resume) {
+            String ready = "READY:" + String(wsUploadReceived);
+            wsServer->sendTXT(num, ready);
+          } else {
+            wsServer->sendTXT(num, "READY");
+          }
+
+          // Zero-length files and partials that were already complete are finished without any data frame
+          if (wsUploadReceived >= wsUploadSize) {
+            finishWsUpload(num);
+          }
         } else {
           wsServer->sendTXT(num, "ERROR:Invalid START format");
         }
@@ -1266,38 +1583,31 @@ void CrossPointWebServer::onWebSocketEvent(uint8_t num, WStype_t type, uint8_t*
       }
 
       wsUploadReceived += written;
+      lastTransferActivity = millis();
+
+      // Acknowledge only what is on the card, so a resume never skips data lost in a write cache. Flushing every
+      // chunk would rewrite the FAT and directory entry each time, so it is batched by size and time.
+      const bool ackDue = wsUploadReceived - wsLastAckSent >= WS_ACK_BYTES ||
+                          lastTransferActivity - wsLastAckAt >= WS_ACK_INTERVAL_MS;
+      if (wsUploadResumable && ackDue && wsUploadReceived < wsUploadSize) {
+        wsUploadFile.flush();
+        esp_task_wdt_reset();
+        String ack = "ACK:" + String(wsUploadReceived);
+        wsServer->sendTXT(num, ack);
+        wsLastAckSent = wsUploadReceived;
+        wsLastAckAt = lastTransferActivity;
+      }
 
       // Send progress update (every 64KB or at end)
-      static size_t lastProgressSent = 0;
-      if (wsUploadReceived - lastProgressSent >= 65536 || wsUploadReceived >= wsUploadSize) {
+      if (wsUploadReceived - wsLastProgressSent >= 65536 || wsUploadReceived >= wsUploadSize) {
         String progress = "PROGRESS:" + String(wsUploadReceived) + ":" + String(wsUploadSize);
         wsServer->sendTXT(num, progress);
-        lastProgressSent = wsUploadReceived;
+        wsLastProgressSent = wsUploadReceived;
       }
 
       // Check if upload complete
       if (wsUploadReceived >= wsUploadSize) {
-        wsUploadFile.close();
-        wsUploadInProgress = false;
-
-        wsLastCompleteName = wsUploadFileName;
-        wsLastCompleteSize = wsUploadSize;
-        wsLastCompleteAt = millis();
-
-        unsigned long elapsed = millis() - wsUploadStartTime;
-        float kbps = (elapsed > 0) ? (wsUploadSize / 1024.0) / (elapsed / 1000.0) : 0;
-
-        LOG_DBG("WS", "Upload complete: %s (%d bytes in %lu ms, %.1f KB/s)", wsUploadFileName.c_str(), wsUploadSize,
-                elapsed, kbps);
-
-        // Clear epub cache to prevent stale metadata issues when overwriting files
-        String filePath = wsUploadPath;
-        if (!filePath.endsWith("/")) filePath += "/";
-        filePath += wsUploadFileName;
-        clearEpubCacheIfNeeded(filePath);
-
-        wsServer->sendTXT(num, "DONE");
-        lastProgressSent = 0;
+        finishWsUpload(num);
       }
       break;
     }
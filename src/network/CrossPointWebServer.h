@@ -80,6 +80,7 @@ class CrossPointWebServer {
 
   // WebSocket upload state
   void onWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
+  void finishWsUpload(uint8_t num);
   static void wsEventCallback(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
 
   // File scanning
@@ -91,6 +92,7 @@ class CrossPointWebServer {
   void handleRoot() const;
   void handleNotFound() const;
   void handleStatus() const;
+  void handlePerf() const;
   void handleFileList() const;
   void handleFileListData() const;
   void handleDownload() const;
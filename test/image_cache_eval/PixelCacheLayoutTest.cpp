@@ -0,0 +1,109 @@
+#include <PixelCacheLayout.h>
+
+#include <iostream>
+#include <map>
+#include <string>
+
+constexpr int SCREEN_WIDTH = 480;
+constexpr int SCREEN_HEIGHT = 800;
+constexpr int PORTRAIT = 0;
+constexpr int LANDSCAPE = 1;
+
+struct Rect {
+  int x;
+  int y;
+  int width;
+  int height;
+};
+
+int failures = 0;
+
+void expect(const bool condition, const std::string& what) {
+  if (!condition) {
+    std::cerr << "FAIL: " << what << "\n";
+    failures++;
+  }
+}
+
+// Stands in for the SD card: cache path -> rect written by the decoder
+using Store = std::map<std::string, Rect>;
+
+// What ImageBlock does for one placement: reuse a cache holding the clipped rect, otherwise decode and write one.
+// Returns true when the decoder ran.
+bool renderImage(Store& store, const std::string& imagePath, const Rect& placement, const int orientation) {
+  Rect visible = placement;
+  if (!pixel_cache::clipToScreen(visible.x, visible.y, visible.width, visible.height, SCREEN_WIDTH, SCREEN_HEIGHT)) {
+    return false;
+  }
+  const std::string path = pixel_cache::pathFor(imagePath, placement.x, placement.y, orientation);
+  const auto it = store.find(path);
+  if (it != store.end() && it->second.x == visible.x && it->second.y == visible.y &&
+      it->second.width == visible.width && it->second.height == visible.height) {
+    return false;
+  }
+  store[path] = visible;
+  return true;
+}
+
+void testPathFormat() {
+  const std::string base = "/.crosspoint/epub_1/img_0123456789abcdef";
+  expect(pixel_cache::pathFor(base + ".jpg", 12, 340, PORTRAIT) == base + ".12_340_0.pxc", "path: extension replaced");
+  expect(pixel_cache::pathFor(base, 12, 340, LANDSCAPE) == base + ".12_340_1.pxc", "path: no extension");
+  expect(pixel_cache::pathFor("/dir.d/img", 0, 0, PORTRAIT) == "/dir.d/img.0_0_0.pxc", "path: dot in directory only");
+}
+
+// The same image on two pages: prerendering the second placement must not evict the first
+void testSameImageTwoPositions() {
+  Store store;
+  const std::string image = "/cache/img_00000000000000aa.png";
+  const Rect top = {20, 40, 200, 150};
+  const Rect lower = {20, 400, 200, 150};
+
+  expect(renderImage(store, image, top, PORTRAIT), "two positions: first placement decodes");
+  expect(renderImage(store, image, lower, PORTRAIT), "two positions: second placement decodes");
+  expect(store.size() == 2, "two positions: one cache file per placement");
+  expect(!renderImage(store, image, top, PORTRAIT), "two positions: first placement still cached");
+  expect(!renderImage(store, image, lower, PORTRAIT), "two positions: second placement still cached");
+}
+
+void testOrientationChange() {
+  Store store;
+  const std::string image = "/cache/img_00000000000000bb.jpg";
+  const Rect placement = {10, 10, 100, 100};
+
+  expect(renderImage(store, image, placement, PORTRAIT), "orientation: portrait decodes");
+  expect(renderImage(store, image, placement, LANDSCAPE), "orientation: landscape decodes");
+  expect(!renderImage(store, image, placement, PORTRAIT), "orientation: portrait still cached");
+}
+
+void testClipping() {
+  int x = 400, y = 700, width = 200, height = 150;
+  expect(pixel_cache::clipToScreen(x, y, width, height, SCREEN_WIDTH, SCREEN_HEIGHT), "clip: partly visible");
+  expect(x == 400 && y == 700 && width == 80 && height == 100, "clip: right and bottom trimmed");
+
+  x = -30, y = -10, width = 100, height = 50;
+  expect(pixel_cache::clipToScreen(x, y, width, height, SCREEN_WIDTH, SCREEN_HEIGHT), "clip: negative origin");
+  expect(x == 0 && y == 0 && width == 70 && height == 40, "clip: left and top trimmed");
+
+  x = SCREEN_WIDTH, y = 0, width = 10, height = 10;
+  expect(!pixel_cache::clipToScreen(x, y, width, height, SCREEN_WIDTH, SCREEN_HEIGHT), "clip: fully off screen");
+
+  // An image running off the bottom is cached as its visible part and reused on the next render
+  Store store;
+  const Rect tall = {0, 600, 300, 400};
+  expect(renderImage(store, "/cache/img_00000000000000cc.png", tall, PORTRAIT), "clip: overflowing image decodes");
+  expect(!renderImage(store, "/cache/img_00000000000000cc.png", tall, PORTRAIT), "clip: overflowing image cached");
+}
+
+int main() {
+  testPathFormat();
+  testSameImageTwoPositions();
+  testOrientationChange();
+  testClipping();
+  if (failures > 0) {
+    std::cerr << failures << " check(s) failed\n";
+    return 1;
+  }
+  std::cout << "All pixel cache layout checks passed\n";
+  return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="$ROOT_DIR/build/image_cache_eval"
+BINARY="$BUILD_DIR/PixelCacheLayoutTest"
+
+mkdir -p "$BUILD_DIR"
+
+SOURCES=(
+  "$ROOT_DIR/test/image_cache_eval/PixelCacheLayoutTest.cpp"
+)
+
+CXXFLAGS=(
+  -std=c++20
+  -O1
+  -g
+  -Wall
+  -Wextra
+  -pedantic
+  -fsanitize=address,undefined
+  -fno-omit-frame-pointer
+  -I"$ROOT_DIR/lib/Epub/Epub/converters"
+)
+
+c++ "${CXXFLAGS[@]}" "${SOURCES[@]}" -o "$BINARY"
+
+"$BINARY" "$@"
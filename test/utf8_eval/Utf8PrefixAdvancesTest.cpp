@@ -0,0 +1,63 @@
+#include <Utf8.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Each codepoint advances by 10, the replacement glyph by 7, so partial tails are visible in the results
+int advanceOf(const uint32_t cp) { return cp == REPLACEMENT_GLYPH ? 7 : 10; }
+
+int failures = 0;
+
+void expect(const bool condition, const std::string& what) {
+  if (!condition) {
+    std::cerr << "FAIL: " << what << "\n";
+    failures++;
+  }
+}
+
+void testWholeCodepoints() {
+  const std::string word = "a\xC3\xA9\xE2\x82\xAC";  // "aé€"
+  std::vector<uint16_t> advances;
+  utf8PrefixAdvances(word, advanceOf, advances);
+  const std::vector<uint16_t> expected = {0, 10, 10, 20, 20, 20, 30};
+  expect(advances == expected, "whole codepoints: advances at every byte offset");
+}
+
+// ChapterHtmlSlimParser splits long words at a byte limit, so a word can end inside a codepoint
+void testWordCutInsideCodepoint() {
+  const std::string euro = "\xE2\x82\xAC";
+  for (size_t keep = 1; keep < euro.size(); keep++) {
+    // Long enough to live on the heap, where reading past the end is caught by the sanitizers
+    const std::string word = std::string(198, 'a') + euro.substr(0, keep);
+    std::vector<uint16_t> advances;
+    utf8PrefixAdvances(word, advanceOf, advances);
+    expect(advances.size() == word.size() + 1, "cut word: one entry per byte offset");
+    expect(advances[198] == 1980, "cut word: advance before the partial codepoint");
+    for (size_t i = 199; i < word.size(); i++) {
+      expect(advances[i] == 1980, "cut word: bytes of the partial codepoint keep the advance before it");
+    }
+    expect(advances.back() == 1987, "cut word: partial tail measures as the replacement glyph");
+  }
+}
+
+void testBoundedDecode() {
+  const unsigned char bytes[] = {0xE2, 0x82};
+  const unsigned char* cursor = bytes;
+  expect(utf8NextCodepoint(&cursor, bytes + sizeof(bytes)) == REPLACEMENT_GLYPH, "bounded decode: partial sequence");
+  expect(cursor == bytes + sizeof(bytes), "bounded decode: cursor stops at end");
+  expect(utf8NextCodepoint(&cursor, bytes + sizeof(bytes)) == 0, "bounded decode: nothing after end");
+}
+
+int main() {
+  testWholeCodepoints();
+  testWordCutInsideCodepoint();
+  testBoundedDecode();
+  if (failures > 0) {
+    std::cerr << failures << " check(s) failed\n";
+    return 1;
+  }
+  std::cout << "All UTF-8 prefix advance checks passed\n";
+  return 0;
+}